@@ -1,4 +1,5 @@
 import os
+import sys
 
 Import("env")
 
@@ -7,3 +8,24 @@ env.Replace(COMPILATIONDB_INCLUDE_TOOLCHAIN=True)
 
 # override compilation DB path
 env.Replace(COMPILATIONDB_PATH="compile_commands.json")
+
+# bake the show folder into flash - show_data.cpp is generated into the build
+# dir so the source tree stays clean
+project_dir = env.subst("$PROJECT_DIR")
+show_src_dir = os.path.join(env.subst("$BUILD_DIR"), "show_src")
+sys.path.insert(0, project_dir)
+import show_compiler
+
+try:
+    os.makedirs(show_src_dir, exist_ok=True)
+    show = show_compiler.compile_show(
+        os.path.join(project_dir, env.GetProjectOption("custom_show_dir", "show")),
+        os.path.join(show_src_dir, "show_data.cpp"),
+        int(env.GetProjectOption("custom_show_frame_ms", show_compiler.DEFAULT_FRAME_MS)),
+        float(env.GetProjectOption("custom_show_tolerance", show_compiler.DEFAULT_TOLERANCE)),
+    )
+except show_compiler.ShowError as e:
+    print(f"show: {e}")
+    env.Exit(1)
+show_compiler.print_report(show)
+env.BuildSources(os.path.join("$BUILD_DIR", "show"), show_src_dir)
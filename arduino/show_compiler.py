@@ -0,0 +1,488 @@
+"""
+Show compiler - bakes the ILDA (.ild) and SVG (.svg) files in the show folder
+into flash as show_data.cpp (see src/renderer/show.h).
+
+Assets play in file name order. Every ILDA frame and every SVG becomes one
+show frame. Points are quantised to the 8 bit field, blanked runs are cut
+down to the move that ends them and straight runs are simplified - the
+renderer interpolates lines itself, so only corners need storing. SVG curves
+are kept as the renderer's own Bezier control points and circles as arcs.
+
+Run from extra_script.py before every build, which writes the output into
+the build dir (.pio/build/<env>/show_src) - it is only rewritten when it
+changes. Usable on its own too:
+
+    python show_compiler.py show show_data.cpp
+"""
+
+import math
+import os
+import re
+import struct
+import sys
+import xml.etree.ElementTree as ET
+
+# Point flags (src/types.h)
+BLANK = 0x40
+CURVE_CONTROL = 0x01
+ARC_CENTRE = 0x02
+ARC_CLOCKWISE = 0x04
+
+SPRITE_BUILTIN_COUNT = 6  # src/renderer/sprite.h
+SPRITE_MAX_POINTS = 255
+MAX_SPRITES = 256 - SPRITE_BUILTIN_COUNT
+
+# Flash per item on AVR
+POINT_BYTES = 3  # sprite_point_t
+SPRITE_BYTES = 3  # sprite_t
+FRAME_BYTES = 4  # show_frame_t
+
+DEFAULT_FRAME_MS = 40
+DEFAULT_TOLERANCE = 0.5  # coord8 units a simplified line may move
+ARC_SEGMENTS = 32  # Lines per turn for ellipses and SVG arcs
+
+
+class ShowError(Exception):
+    pass
+
+
+# ----------------------------------------------------------------------------
+# ILDA
+# ----------------------------------------------------------------------------
+
+# format: (record size, has z)
+ILDA_FORMATS = {0: (8, True), 1: (6, False), 4: (10, True), 5: (8, False)}
+ILDA_BLANK = 0x40
+
+
+def load_ilda(path):
+    """Frames of (x, y, flags) in 0..255 floats."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    frames = []
+    pos = 0
+    while pos + 32 <= len(data):
+        if data[pos : pos + 4] != b"ILDA":
+            raise ShowError(f"{path}: bad ILDA header at byte {pos}")
+        fmt = data[pos + 7]
+        (count,) = struct.unpack_from(">H", data, pos + 24)
+        pos += 32
+        if count == 0:
+            break  # End of file header
+
+        if fmt == 2:  # Palette
+            pos += count * 3
+            continue
+        if fmt not in ILDA_FORMATS:
+            raise ShowError(f"{path}: ILDA format {fmt} not supported")
+
+        size, has_z = ILDA_FORMATS[fmt]
+        status_at = 6 if has_z else 4
+        points = []
+        for i in range(count):
+            rec = pos + i * size
+            x, y = struct.unpack_from(">hh", data, rec)
+            status = data[rec + status_at]
+            points.append(
+                (
+                    (x + 32768) / 256.0,
+                    (y + 32768) / 256.0,
+                    BLANK if status & ILDA_BLANK else 0,
+                )
+            )
+        pos += count * size
+        frames.append(points)
+
+    if not frames:
+        raise ShowError(f"{path}: no frames")
+    return frames
+
+
+# ----------------------------------------------------------------------------
+# SVG
+# ----------------------------------------------------------------------------
+
+_NUMBER = r"[-+]?(?:\d*\.\d+|\d+\.?)(?:[eE][-+]?\d+)?"
+
+
+def _numbers(text):
+    return [float(v) for v in re.findall(_NUMBER, text or "")]
+
+
+def _local(tag):
+    return tag.rsplit("}", 1)[-1]
+
+
+def _arc_lines(x0, y0, rx, ry, phi, large, sweep, x1, y1):
+    """SVG elliptical arc as line end points (endpoint to centre form)."""
+    if rx == 0 or ry == 0 or (x0, y0) == (x1, y1):
+        return [(x1, y1)]
+    rx, ry = abs(rx), abs(ry)
+    cos_p, sin_p = math.cos(math.radians(phi)), math.sin(math.radians(phi))
+    dx, dy = (x0 - x1) / 2, (y0 - y1) / 2
+    px = cos_p * dx + sin_p * dy
+    py = -sin_p * dx + cos_p * dy
+    grow = (px * px) / (rx * rx) + (py * py) / (ry * ry)
+    if grow > 1:
+        rx, ry = rx * math.sqrt(grow), ry * math.sqrt(grow)
+    num = rx * rx * ry * ry - rx * rx * py * py - ry * ry * px * px
+    den = rx * rx * py * py + ry * ry * px * px
+    k = math.sqrt(max(0.0, num / den)) * (-1 if large == sweep else 1)
+    cpx, cpy = k * rx * py / ry, -k * ry * px / rx
+    cx = cos_p * cpx - sin_p * cpy + (x0 + x1) / 2
+    cy = sin_p * cpx + cos_p * cpy + (y0 + y1) / 2
+
+    def angle(ux, uy):
+        return math.atan2(uy, ux)
+
+    a0 = angle((px - cpx) / rx, (py - cpy) / ry)
+    a1 = angle((-px - cpx) / rx, (-py - cpy) / ry)
+    delta = a1 - a0
+    if sweep and delta < 0:
+        delta += 2 * math.pi
+    elif not sweep and delta > 0:
+        delta -= 2 * math.pi
+
+    n = max(1, int(math.ceil(abs(delta) / (2 * math.pi) * ARC_SEGMENTS)))
+    out = []
+    for i in range(1, n + 1):
+        a = a0 + delta * i / n
+        ex, ey = rx * math.cos(a), ry * math.sin(a)
+        out.append((cos_p * ex - sin_p * ey + cx, sin_p * ex + cos_p * ey + cy))
+    out[-1] = (x1, y1)
+    return out
+
+
+def _path_points(d):
+    """(x, y, flags) for an SVG path, in SVG units."""
+    tokens = re.findall(r"[MmLlHhVvCcSsQqTtAaZz]|" + _NUMBER, d)
+    out = []
+    cmd = None
+    x = y = sx = sy = 0.0
+    last_ctrl = None  # Reflected by S/T
+    i = 0
+
+    def take(n):
+        nonlocal i
+        vals = [float(v) for v in tokens[i : i + n]]
+        if len(vals) < n:
+            raise ShowError(f"truncated path data: {d[:40]}")
+        i += n
+        return vals
+
+    while i < len(tokens):
+        if re.match(r"[A-Za-z]", tokens[i]):
+            cmd = tokens[i]
+            i += 1
+        elif cmd is None:
+            raise ShowError(f"number without a command in path data: {d[:40]}")
+
+        rel = cmd.islower()
+        c = cmd.upper()
+        ox, oy = (x, y) if rel else (0.0, 0.0)
+        prev_ctrl, last_ctrl = last_ctrl, None
+
+        if c == "Z":
+            out.append((sx, sy, 0))
+            x, y = sx, sy
+            cmd = None  # Takes no numbers
+            continue
+        if c == "M":
+            x, y = take(2)
+            x, y = x + ox, y + oy
+            sx, sy = x, y
+            out.append((x, y, BLANK))
+            cmd = "l" if rel else "L"  # Further pairs are lines
+        elif c == "L":
+            x, y = take(2)
+            x, y = x + ox, y + oy
+            out.append((x, y, 0))
+        elif c == "H":
+            (x,) = take(1)
+            x += ox
+            out.append((x, y, 0))
+        elif c == "V":
+            (y,) = take(1)
+            y += oy
+            out.append((x, y, 0))
+        elif c in "CS":
+            if c == "C":
+                x1, y1, x2, y2, ex, ey = take(6)
+                x1, y1 = x1 + ox, y1 + oy
+            else:
+                x2, y2, ex, ey = take(4)
+                x1, y1 = (2 * x - prev_ctrl[0], 2 * y - prev_ctrl[1]) if (
+                    prev_ctrl and prev_ctrl[2] == "C"
+                ) else (x, y)
+            x2, y2, ex, ey = x2 + ox, y2 + oy, ex + ox, ey + oy
+            out += [(x1, y1, CURVE_CONTROL), (x2, y2, CURVE_CONTROL), (ex, ey, 0)]
+            last_ctrl = (x2, y2, "C")
+            x, y = ex, ey
+        elif c in "QT":
+            if c == "Q":
+                x1, y1, ex, ey = take(4)
+                x1, y1 = x1 + ox, y1 + oy
+            else:
+                ex, ey = take(2)
+                x1, y1 = (2 * x - prev_ctrl[0], 2 * y - prev_ctrl[1]) if (
+                    prev_ctrl and prev_ctrl[2] == "Q"
+                ) else (x, y)
+            ex, ey = ex + ox, ey + oy
+            out += [(x1, y1, CURVE_CONTROL), (ex, ey, 0)]
+            last_ctrl = (x1, y1, "Q")
+            x, y = ex, ey
+        elif c == "A":
+            rx, ry, phi, large, sweep, ex, ey = take(7)
+            ex, ey = ex + ox, ey + oy
+            for px, py in _arc_lines(x, y, rx, ry, phi, int(large), int(sweep), ex, ey):
+                out.append((px, py, 0))
+            x, y = ex, ey
+    return out
+
+
+def _element_points(el):
+    tag = _local(el.tag)
+    get = lambda name: float(el.get(name, 0))
+    if tag == "path":
+        return _path_points(el.get("d", ""))
+    if tag == "line":
+        return [(get("x1"), get("y1"), BLANK), (get("x2"), get("y2"), 0)]
+    if tag in ("polyline", "polygon"):
+        v = _numbers(el.get("points"))
+        pts = [(v[i], v[i + 1], 0) for i in range(0, len(v) - 1, 2)]
+        if not pts:
+            return []
+        pts[0] = (pts[0][0], pts[0][1], BLANK)
+        if tag == "polygon":
+            pts.append((pts[0][0], pts[0][1], 0))
+        return pts
+    if tag == "rect":
+        x, y, w, h = get("x"), get("y"), get("width"), get("height")
+        return [(x, y, BLANK), (x + w, y, 0), (x + w, y + h, 0), (x, y + h, 0), (x, y, 0)]
+    if tag == "circle":
+        cx, cy, r = get("cx"), get("cy"), get("r")
+        return [(cx + r, cy, BLANK), (cx, cy, ARC_CENTRE), (cx + r, cy, 0)]
+    if tag == "ellipse":
+        cx, cy, rx, ry = get("cx"), get("cy"), get("rx"), get("ry")
+        pts = [(cx + rx, cy, BLANK)]
+        for i in range(1, ARC_SEGMENTS + 1):
+            a = 2 * math.pi * i / ARC_SEGMENTS
+            pts.append((cx + rx * math.cos(a), cy + ry * math.sin(a), 0))
+        return pts
+    return []
+
+
+def load_svg(path):
+    """One frame of (x, y, flags) in 0..255 floats. Transforms are ignored."""
+    try:
+        root = ET.parse(path).getroot()
+    except ET.ParseError as e:
+        raise ShowError(f"{path}: {e}")
+
+    points = []
+    for el in root.iter():
+        points += _element_points(el)
+    if not points:
+        raise ShowError(f"{path}: nothing to draw")
+
+    box = _numbers(root.get("viewBox"))
+    if len(box) != 4:
+        xs = [p[0] for p in points]
+        ys = [p[1] for p in points]
+        box = [min(xs), min(ys), max(xs) - min(xs), max(ys) - min(ys)]
+    min_x, min_y, w, h = box
+    scale = 255.0 / max(w, h, 1e-9)
+    pad_x = (255.0 - w * scale) / 2
+    pad_y = (255.0 - h * scale) / 2
+
+    # SVG y runs down the page, the field's runs up
+    return [
+        [
+            ((x - min_x) * scale + pad_x, 255.0 - ((y - min_y) * scale + pad_y), f)
+            for x, y, f in points
+        ]
+    ]
+
+
+# ----------------------------------------------------------------------------
+# Frames to sprites
+# ----------------------------------------------------------------------------
+
+
+def _q(v):
+    return min(255, max(0, int(round(v))))
+
+
+def _line_error(a, b, p):
+    """Distance from p to the line a-b."""
+    dx, dy = b[0] - a[0], b[1] - a[1]
+    length = math.hypot(dx, dy)
+    if length == 0:
+        return math.hypot(p[0] - a[0], p[1] - a[1])
+    return abs(dx * (p[1] - a[1]) - dy * (p[0] - a[0])) / length
+
+
+def _simplify(run, tolerance):
+    """Ramer-Douglas-Peucker over a lit polyline, end points kept."""
+    if len(run) < 3:
+        return run
+    worst, at = 0.0, 0
+    for i in range(1, len(run) - 1):
+        e = _line_error(run[0], run[-1], run[i])
+        if e > worst:
+            worst, at = e, i
+    if worst <= tolerance:
+        return [run[0], run[-1]]
+    return _simplify(run[: at + 1], tolerance)[:-1] + _simplify(run[at:], tolerance)
+
+
+def compact_frame(points, tolerance=DEFAULT_TOLERANCE):
+    """Quantised (x, y, flags), 0..255, with redundant points dropped."""
+    out = []
+    i = 0
+    while i < len(points):
+        x, y, f = points[i]
+        if f & BLANK and not f & (CURVE_CONTROL | ARC_CENTRE):
+            # Only the end of a blanked run is a destination
+            while i + 1 < len(points) and points[i + 1][2] == BLANK:
+                i += 1
+                x, y, f = points[i]
+            out.append((x, y, f))
+            i += 1
+            continue
+        if f or (out and out[-1][2] & (CURVE_CONTROL | ARC_CENTRE)):
+            # Curve ends stay where they are
+            out.append((x, y, f))
+            i += 1
+            continue
+
+        # Lit polyline from the previous point
+        run = [out[-1] if out else (x, y, f)]
+        while i < len(points) and points[i][2] == 0:
+            run.append(points[i])
+            i += 1
+        out += _simplify(run, tolerance)[1:]
+
+    quantised = []
+    for x, y, f in out:
+        p = (_q(x), _q(y), f)
+        # Lit repeats draw nothing
+        if quantised and not f and quantised[-1][:2] == p[:2] and not quantised[-1][2] & (
+            CURVE_CONTROL | ARC_CENTRE
+        ):
+            continue
+        quantised.append(p)
+    if not quantised:
+        return []
+    first = quantised[0]
+    quantised[0] = (first[0], first[1], first[2] | BLANK)
+    return quantised
+
+
+def _split(points):
+    """Chunks of at most SPRITE_MAX_POINTS, never ending on a control point."""
+    chunks = []
+    while points:
+        n = min(len(points), SPRITE_MAX_POINTS)
+        while n < len(points) and points[n - 1][2] & (CURVE_CONTROL | ARC_CENTRE):
+            n -= 1
+        chunks.append(points[:n])
+        points = points[n:]
+    return chunks
+
+
+class Show:
+    def __init__(self):
+        self.sprites = []  # Lists of (x, y, flags)
+        self.frames = []  # (first sprite id, sprite count, ms)
+        self.report = []  # (asset, frames, points, flash bytes)
+
+    def add_asset(self, name, frames, frame_ms, tolerance):
+        points_total = 0
+        sprites_before = len(self.sprites)
+        frames_added = 0
+        for frame in frames:
+            points = compact_frame(frame, tolerance)
+            if not points:
+                continue
+            chunks = _split(points)
+            first = SPRITE_BUILTIN_COUNT + len(self.sprites)
+            self.sprites += chunks
+            self.frames.append((first, len(chunks), frame_ms))
+            points_total += len(points)
+            frames_added += 1
+
+        if len(self.sprites) > MAX_SPRITES:
+            raise ShowError(
+                f"{name}: show needs {len(self.sprites)} sprites, at most {MAX_SPRITES} fit the 8 bit ids"
+            )
+        flash = (
+            points_total * POINT_BYTES
+            + (len(self.sprites) - sprites_before) * SPRITE_BYTES
+            + frames_added * FRAME_BYTES
+        )
+        self.report.append((name, frames_added, points_total, flash))
+
+    def source(self):
+        lines = [
+            "// Generated by show_compiler.py from the show folder - do not edit",
+            '#include "renderer/show.h"',
+            "",
+        ]
+        for i, sprite in enumerate(self.sprites):
+            lines.append(f"static const sprite_point_t show_points_{i}[] PROGMEM = {{")
+            for j in range(0, len(sprite), 8):
+                row = sprite[j : j + 8]
+                lines.append("    " + " ".join(f"{{{x - 128}, {y - 128}, {f}}}," for x, y, f in row))
+            lines += ["};", ""]
+
+        # Zero length arrays aren't allowed - an empty show keeps a dummy entry
+        entries = [f"{{show_points_{i}, {len(s)}}}" for i, s in enumerate(self.sprites)]
+        frames = [f"{{{s}, {n}, {ms}}}" for s, n, ms in self.frames]
+        lines.append("const sprite_t show_sprite_table[] PROGMEM = {")
+        lines += [f"    {e}," for e in entries or ["{nullptr, 0}"]]
+        lines += ["};", f"const uint8_t show_sprite_count = {len(self.sprites)};", ""]
+        lines.append("const show_frame_t show_frames[] PROGMEM = {")
+        lines += [f"    {f}," for f in frames or ["{0, 0, 0}"]]
+        lines += ["};", f"const uint16_t show_frame_count = {len(self.frames)};", ""]
+        return "\n".join(lines)
+
+
+def compile_show(show_dir, out_path, frame_ms=DEFAULT_FRAME_MS, tolerance=DEFAULT_TOLERANCE):
+    """Write out_path if it changed. Returns the Show."""
+    show = Show()
+    names = sorted(os.listdir(show_dir)) if os.path.isdir(show_dir) else []
+    for name in names:
+        path = os.path.join(show_dir, name)
+        ext = os.path.splitext(name)[1].lower()
+        if ext == ".ild":
+            show.add_asset(name, load_ilda(path), frame_ms, tolerance)
+        elif ext == ".svg":
+            show.add_asset(name, load_svg(path), frame_ms, tolerance)
+
+    source = show.source()
+    old = None
+    if os.path.exists(out_path):
+        with open(out_path) as f:
+            old = f.read()
+    if source != old:
+        with open(out_path, "w") as f:
+            f.write(source)
+    return show
+
+
+def print_report(show):
+    for name, frames, points, flash in show.report:
+        print(f"show: {name}: {frames} frames, {points} points, {flash} bytes flash")
+    total = sum(r[3] for r in show.report)
+    print(f"show: {len(show.frames)} frames, {len(show.sprites)} sprites, {total} bytes flash")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    try:
+        print_report(compile_show(sys.argv[1], sys.argv[2]))
+    except ShowError as e:
+        sys.exit(f"show: {e}")
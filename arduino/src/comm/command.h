@@ -1,6 +1,12 @@
 #pragma once
 #include "../config.h"
+#include "../diagnostics/memory.h"
+#include "../diagnostics/profiler.h"
+#include "../diagnostics/trace.h"
 #include "../hardware/hardware.h"
+#include "../renderer/renderer.h"
+#include "../renderer/show.h"
+#include "wire_decoder.h"
 #include "StaticSerialCommands.h"
 #include <Arduino.h>
 #include <avr/wdt.h>
@@ -25,6 +31,19 @@ constexpr auto arg_pin = ARG(ArgType::Int, 3, 9, "pin");
 constexpr auto arg_u32 = ARG(ArgType::Int, "uint32");
 constexpr auto arg_u16 = ARG(ArgType::Int, 0, 65535, "uint16");
 constexpr auto arg_u8 = ARG(ArgType::Int, 0, 255, "uint8");
+constexpr auto arg_hex = ARG(ArgType::String, "hex");
+constexpr auto arg_offset = ARG(ArgType::Int, -128, 127, "offset");
+constexpr auto arg_laser_mode =
+    ARG(ArgType::Int, LASER_MODE_GPIO, LASER_MODE_TIMER, "mode");
+constexpr auto arg_laser_delay =
+    ARG(ArgType::Int, -MAX_LASER_DELAY, MAX_LASER_DELAY, "steps");
+constexpr auto arg_curve_index =
+    ARG(ArgType::Int, 0, DWELL_CURVE_POINTS - 1, "index");
+#if ENABLE_GRID
+constexpr auto arg_grid_node = ARG(ArgType::Int, 0, GRID_NODES - 1, "node");
+constexpr auto arg_grid_offset =
+    ARG(ArgType::Int, -GRID_MAX_OFFSET, GRID_MAX_OFFSET, "offset");
+#endif
 
 void cmd_help(SerialCommands &sender, Args &args) {
   sender.getSerial().println(F("Available commands:"));
@@ -93,6 +112,25 @@ void cmd_set_laser_pin(SerialCommands &sender, Args &args) {
   sender.getSerial().println(g_config.laser.pin);
 }
 
+void cmd_set_laser_mode(SerialCommands &sender, Args &args) {
+  g_config.laser.mode = args[0].getInt();
+  sender.getSerial().print(F("Laser mode set to "));
+  sender.getSerial().println(g_config.laser.mode);
+}
+
+void cmd_set_laser_edge(SerialCommands &sender, Args &args) {
+  g_config.laser.edge_offset = args[0].getInt();
+  sender.getSerial().print(F("Laser edge offset set to "));
+  sender.getSerial().println(g_config.laser.edge_offset);
+}
+
+void cmd_set_laser_delay(SerialCommands &sender, Args &args) {
+  g_config.laser.delay = args[0].getInt();
+  renderer.update_laser_delay();
+  sender.getSerial().print(F("Laser delay set to "));
+  sender.getSerial().println(g_config.laser.delay);
+}
+
 void cmd_set_laser_on_dwell(SerialCommands &sender, Args &args) {
   g_config.renderer.laser_on_dwell = args[0].getInt();
   sender.getSerial().print(F("Laser on dwell set to "));
@@ -107,34 +145,110 @@ void cmd_set_laser_off_dwell(SerialCommands &sender, Args &args) {
 
 void cmd_set_max_step_size(SerialCommands &sender, Args &args) {
   g_config.renderer.max_step_size = args[0].getInt();
+  interp_configure();
   sender.getSerial().print(F("Max step size set to "));
   sender.getSerial().println(g_config.renderer.max_step_size);
 }
 void cmd_set_acc_factor(SerialCommands &sender, Args &args) {
   g_config.renderer.acc_factor = args[0].getInt();
+  interp_configure();
   sender.getSerial().print(F("Acc factor set to "));
   sender.getSerial().println(g_config.renderer.acc_factor);
 }
 void cmd_set_dec_factor(SerialCommands &sender, Args &args) {
   g_config.renderer.dec_factor = args[0].getInt();
+  interp_configure();
   sender.getSerial().print(F("Dec factor set to "));
   sender.getSerial().println(g_config.renderer.dec_factor);
 }
+void cmd_set_blank_step_size(SerialCommands &sender, Args &args) {
+  g_config.renderer.blank_step_size = args[0].getInt();
+  interp_configure();
+  sender.getSerial().print(F("Blank step size set to "));
+  sender.getSerial().println(g_config.renderer.blank_step_size);
+}
+void cmd_set_blank_acc_factor(SerialCommands &sender, Args &args) {
+  g_config.renderer.blank_acc_factor = args[0].getInt();
+  interp_configure();
+  sender.getSerial().print(F("Blank acc factor set to "));
+  sender.getSerial().println(g_config.renderer.blank_acc_factor);
+}
+void cmd_set_blank_dec_factor(SerialCommands &sender, Args &args) {
+  g_config.renderer.blank_dec_factor = args[0].getInt();
+  interp_configure();
+  sender.getSerial().print(F("Blank dec factor set to "));
+  sender.getSerial().println(g_config.renderer.blank_dec_factor);
+}
+void cmd_set_corner_dwell(SerialCommands &sender, Args &args) {
+  uint8_t index = args[0].getInt();
+  g_config.renderer.corner_dwell[index] = args[1].getInt();
+  sender.getSerial().print(F("Corner dwell "));
+  sender.getSerial().print(index);
+  sender.getSerial().print(F(" set to "));
+  sender.getSerial().println(g_config.renderer.corner_dwell[index]);
+}
+void cmd_set_jump_dwell(SerialCommands &sender, Args &args) {
+  uint8_t index = args[0].getInt();
+  g_config.renderer.jump_dwell[index] = args[1].getInt();
+  sender.getSerial().print(F("Jump dwell "));
+  sender.getSerial().print(index);
+  sender.getSerial().print(F(" set to "));
+  sender.getSerial().println(g_config.renderer.jump_dwell[index]);
+}
+#if ENABLE_EMPHASIS
+void cmd_set_emphasis(SerialCommands &sender, Args &args) {
+  g_config.renderer.emphasis_x = args[0].getInt();
+  g_config.renderer.emphasis_y = args[1].getInt();
+  renderer.update_emphasis();
+  sender.getSerial().print(F("Emphasis set to "));
+  sender.getSerial().print(g_config.renderer.emphasis_x);
+  sender.getSerial().print(F(" "));
+  sender.getSerial().println(g_config.renderer.emphasis_y);
+}
+#endif
 void cmd_set_flip_x(SerialCommands &sender, Args &args) {
   g_config.renderer.flip_x = args[0].getInt();
+  renderer.update_transform();
   sender.getSerial().print(F("Flip x set to "));
   sender.getSerial().println(g_config.renderer.flip_x);
 }
 void cmd_set_flip_y(SerialCommands &sender, Args &args) {
   g_config.renderer.flip_y = args[0].getInt();
+  renderer.update_transform();
   sender.getSerial().print(F("Flip y set to "));
   sender.getSerial().println(g_config.renderer.flip_y);
 }
 void cmd_set_swap_xy(SerialCommands &sender, Args &args) {
   g_config.renderer.swap_xy = args[0].getInt();
+  renderer.update_transform();
   sender.getSerial().print(F("Swap xy set to "));
   sender.getSerial().println(g_config.renderer.swap_xy);
 }
+void cmd_set_zone(SerialCommands &sender, Args &args) {
+  g_config.renderer.zone_enabled = args[0].getInt();
+  g_config.renderer.zone_x_min = args[1].getInt();
+  g_config.renderer.zone_y_min = args[2].getInt();
+  g_config.renderer.zone_x_max = args[3].getInt();
+  g_config.renderer.zone_y_max = args[4].getInt();
+  sender.getSerial().print(F("Safety zone set to "));
+  sender.getSerial().print(g_config.renderer.zone_enabled);
+  sender.getSerial().print(F(" "));
+  sender.getSerial().print(g_config.renderer.zone_x_min);
+  sender.getSerial().print(F(" "));
+  sender.getSerial().print(g_config.renderer.zone_y_min);
+  sender.getSerial().print(F(" "));
+  sender.getSerial().print(g_config.renderer.zone_x_max);
+  sender.getSerial().print(F(" "));
+  sender.getSerial().println(g_config.renderer.zone_y_max);
+}
+#if ENABLE_GRID
+void cmd_set_grid_correction(SerialCommands &sender, Args &args) {
+  g_config.renderer.grid_correction = args[0].getInt();
+  renderer.update_grid();
+  sender.getSerial().print(F("Grid correction set to "));
+  sender.getSerial().println(g_config.renderer.grid_correction);
+}
+#endif
 
 Command set_commands[]{
     COMMAND(cmd_set_timer_frequency, "timer_freq", arg_u32, nullptr,
@@ -153,6 +267,12 @@ Command set_commands[]{
             "Set the DAC data mode"),
     COMMAND(cmd_set_laser_pin, "laser_pin", arg_pin, nullptr,
             "Set the laser pin"),
+    COMMAND(cmd_set_laser_mode, "laser_mode", arg_laser_mode, nullptr,
+            "Set the laser mode (0 pin, 1 timer) - reload laser to apply"),
+    COMMAND(cmd_set_laser_edge, "laser_edge", arg_u16, nullptr,
+            "Set the timer mode laser edge offset in timer ticks"),
+    COMMAND(cmd_set_laser_delay, "laser_delay", arg_laser_delay, nullptr,
+            "Set the laser delay in steps (+ later, - earlier)"),
     COMMAND(cmd_set_laser_on_dwell, "laser_on_dwell", arg_u8, nullptr,
             "Set the laser on dwell"),
     COMMAND(cmd_set_laser_off_dwell, "laser_off_dwell", arg_u8, nullptr,
@@ -163,9 +283,29 @@ Command set_commands[]{
             "Set the acc factor"),
     COMMAND(cmd_set_dec_factor, "dec_factor", arg_u8, nullptr,
             "Set the dec factor"),
+    COMMAND(cmd_set_blank_step_size, "blank_step_size", arg_u8, nullptr,
+            "Set the blanked move step size"),
+    COMMAND(cmd_set_blank_acc_factor, "blank_acc_factor", arg_u8, nullptr,
+            "Set the blanked move acc factor"),
+    COMMAND(cmd_set_blank_dec_factor, "blank_dec_factor", arg_u8, nullptr,
+            "Set the blanked move dec factor"),
+    COMMAND(cmd_set_corner_dwell, "corner_dwell", arg_curve_index, arg_u8,
+            nullptr, "Set a point of the dwell by corner angle curve"),
+    COMMAND(cmd_set_jump_dwell, "jump_dwell", arg_curve_index, arg_u8, nullptr,
+            "Set a point of the dwell by jump length curve"),
+#if ENABLE_EMPHASIS
+    COMMAND(cmd_set_emphasis, "emphasis", arg_u8, arg_u8, nullptr,
+            "Set the x and y pre-emphasis gain in 1/16ths"),
+#endif
     COMMAND(cmd_set_flip_x, "flip_x", arg_bool, nullptr, "Set the flip x"),
     COMMAND(cmd_set_flip_y, "flip_y", arg_bool, nullptr, "Set the flip y"),
     COMMAND(cmd_set_swap_xy, "swap_xy", arg_bool, nullptr, "Set the swap xy"),
+    COMMAND(cmd_set_zone, "zone", arg_bool, arg_u8, arg_u8, arg_u8, arg_u8,
+            nullptr, "Set the safety zone (on, x/y min, x/y max)"),
+#if ENABLE_GRID
+    COMMAND(cmd_set_grid_correction, "grid_correction", arg_bool, nullptr,
+            "Set the geometric correction grid on or off"),
+#endif
 };
 
 void cmd_set(SerialCommands &sender, Args &args) {
@@ -191,6 +331,11 @@ void cmd_reload_serial(SerialCommands &sender, Args &args) {
 }
 void cmd_reload_all(SerialCommands &sender, Args &args) {
   Hardware::context.update_all_from_config();
+  interp_configure();
+  renderer.update_laser_delay();
+  renderer.update_emphasis();
+  renderer.update_transform();
+  renderer.update_grid();
   sender.getSerial().println(F("All reloaded"));
 }
 
@@ -207,11 +352,385 @@ void cmd_reload(SerialCommands &sender, Args &args) {
                          sizeof(reload_commands) / sizeof(Command));
 }
 
+// Decodes 'frame data' chunks into the pending frame
+WireDecoder wire_decoder;
+uint8_t wire_point_index;
+
+// A rejected chunk starts the decoder and point index over, so no later
+// point lands at a stale index - the host restarts with 'frame begin'
+void frame_data_reset() {
+  wire_decoder.reset();
+  wire_point_index = 0;
+}
+
+// The host taking over ends the built in show
+void frame_begin(SerialCommands &sender, uint8_t point_count, uint8_t format) {
+  show.stop();
+  frame_data_reset();
+
+  if (renderer.begin_frame(point_count, format)) {
+    sender.getSerial().println(F("OK"));
+  } else {
+    sender.getSerial().print(F("ERR: Frame does not fit, free bytes "));
+    sender.getSerial().println(renderer.get_arena().free_bytes());
+  }
+}
+
+void cmd_frame_begin(SerialCommands &sender, Args &args) {
+  frame_begin(sender, args[0].getInt(), FRAME_FORMAT_DELTA);
+}
+
+void cmd_frame_begin_abs(SerialCommands &sender, Args &args) {
+  frame_begin(sender, args[0].getInt(), FRAME_FORMAT_ABSOLUTE);
+}
+
+#if ENABLE_PROGRAMS
+void cmd_frame_begin_prog(SerialCommands &sender, Args &args) {
+  frame_begin(sender, 0, FRAME_FORMAT_PROGRAM);
+}
+#endif
+
+void cmd_frame_begin_sprites(SerialCommands &sender, Args &args) {
+  frame_begin(sender, 0, FRAME_FORMAT_SPRITES);
+}
+
+void cmd_frame_begin_text(SerialCommands &sender, Args &args) {
+  frame_begin(sender, 0, FRAME_FORMAT_TEXT);
+}
+
+void cmd_frame_begin_gen(SerialCommands &sender, Args &args) {
+  frame_begin(sender, 0, FRAME_FORMAT_GENERATOR);
+}
+
+void cmd_frame_point(SerialCommands &sender, Args &args) {
+  point_coord8_t point(args[1].getInt(), args[2].getInt(), args[3].getInt());
+  if (renderer.set_frame_point(args[0].getInt(), point)) {
+    sender.getSerial().println(F("OK"));
+  } else {
+    sender.getSerial().println(
+        F("ERR: Index out of range, out of order or arena full"));
+  }
+}
+
+// Generated frames are appended as they are - anything else is wire-encoded
+// points
+void cmd_frame_data(SerialCommands &sender, Args &args) {
+  const char *hex = args[0].getString();
+  bool raw = FRAME_FORMAT_IS_GENERATED(renderer.get_arena().back.format);
+
+  while (hex[0] && hex[1]) {
+    uint8_t hi = hex_nibble(hex[0]);
+    uint8_t lo = hex_nibble(hex[1]);
+    hex += 2;
+
+    if (hi == 0xFF || lo == 0xFF) {
+      sender.getSerial().println(F("ERR: Bad hex"));
+      return;
+    }
+
+    if (raw) {
+      if (!renderer.append_frame_byte(hi << 4 | lo)) {
+        sender.getSerial().println(F("ERR: Arena full"));
+        return;
+      }
+      continue;
+    }
+
+    switch (wire_decoder.feed(hi << 4 | lo)) {
+    case WIRE_NEED_MORE:
+      break;
+    case WIRE_POINTS:
+      for (uint8_t i = 0; i < wire_decoder.count; i++) {
+        if (!renderer.set_frame_point(wire_point_index, wire_decoder.point)) {
+          frame_data_reset();
+          sender.getSerial().println(F("ERR: Point rejected"));
+          return;
+        }
+        wire_point_index++;
+      }
+      break;
+    case WIRE_ERROR:
+      frame_data_reset();
+      sender.getSerial().println(F("ERR: Bad frame data"));
+      return;
+    }
+  }
+
+  if (hex[0]) {
+    sender.getSerial().println(F("ERR: Odd hex length"));
+    return;
+  }
+
+  sender.getSerial().print(F("OK "));
+  if (raw) {
+    sender.getSerial().println(renderer.get_arena().back.length);
+  } else {
+    sender.getSerial().println(wire_point_index);
+  }
+}
+
+#if ENABLE_FRAME_SUMMARY
+// "steps=N frame_us=N blank_pct=N table=0|1" - parsed by the host. All 0
+// after committing a generated frame; 'frame info' has them once it is drawn.
+void print_frame_summary(Stream &out, const frame_summary_t &summary,
+                         bool table) {
+  out.print(F("steps="));
+  out.print(summary.total_steps);
+  out.print(F(" frame_us="));
+  out.print(summary.frame_us);
+  out.print(F(" blank_pct="));
+  out.print(summary.blank_percent());
+  out.print(F(" table="));
+  out.println(table);
+}
+#endif
+
+void cmd_frame_commit(SerialCommands &sender, Args &args) {
+  if (renderer.commit_frame()) {
+#if ENABLE_FRAME_SUMMARY
+    sender.getSerial().print(F("OK "));
+    print_frame_summary(sender.getSerial(), renderer.get_summary(),
+                        renderer.get_arena().back.has_table());
+#else
+    sender.getSerial().println(F("OK"));
+#endif
+  } else {
+    sender.getSerial().println(F("ERR: No frame to commit or bad frame data"));
+  }
+}
+
+const __FlashStringHelper *frame_format_name(uint8_t format) {
+  switch (format) {
+  case FRAME_FORMAT_DELTA:
+    return F("delta");
+  case FRAME_FORMAT_PROGRAM:
+    return F("program");
+  case FRAME_FORMAT_SPRITES:
+    return F("sprites");
+  case FRAME_FORMAT_TEXT:
+    return F("text");
+  case FRAME_FORMAT_GENERATOR:
+    return F("generator");
+  default:
+    return F("absolute");
+  }
+}
+
+void cmd_frame_info(SerialCommands &sender, Args &args) {
+  const point_arena_t &arena = renderer.get_arena();
+  Stream &out = sender.getSerial();
+
+  out.print(F("Front points: "));
+  out.println(arena.front.point_count);
+  out.print(F("Front bytes: "));
+  out.println(arena.front.length);
+  out.print(F("Front format: "));
+  out.println(frame_format_name(arena.front.format));
+  out.print(F("Back points: "));
+  out.println(arena.back.point_count);
+  out.print(F("Back bytes: "));
+  out.println(arena.back.length);
+  out.print(F("Back committed: "));
+  out.println(arena.back_ready);
+  out.print(F("Free bytes: "));
+  out.println(arena.free_bytes());
+#if ENABLE_FRAME_SUMMARY
+  out.print(F("Last commit: "));
+  print_frame_summary(out, renderer.get_summary(),
+                      arena.back_ready ? arena.back.has_table()
+                                       : arena.front.has_table());
+#endif
+  out.println(F("EOC"));
+}
+
+Command frame_commands[]{
+    COMMAND(cmd_frame_begin, "begin", arg_u8, nullptr,
+            "Start a new delta-compressed frame with N points, sent in order"),
+    COMMAND(cmd_frame_begin_abs, "begin_abs", arg_u8, nullptr,
+            "Start a new absolute frame with N points, any order"),
+#if ENABLE_PROGRAMS
+    COMMAND(cmd_frame_begin_prog, "begin_prog", nullptr,
+            "Start a new display list program, sent with data"),
+#endif
+    COMMAND(cmd_frame_begin_sprites, "begin_sprites", nullptr,
+            "Start a new list of flash sprite instances, sent with data"),
+    COMMAND(cmd_frame_begin_text, "begin_text", nullptr,
+            "Start a new frame of text runs, sent with data"),
+    COMMAND(cmd_frame_begin_gen, "begin_gen", nullptr,
+            "Start a new frame of generated figures, sent with data"),
+    COMMAND(cmd_frame_point, "point", arg_u8, arg_u8, arg_u8, arg_u8, nullptr,
+            "Set point: index x y flags"),
+    COMMAND(cmd_frame_data, "data", arg_hex, nullptr,
+            "Append wire-encoded points (hex) to the pending frame"),
+    COMMAND(cmd_frame_commit, "commit", nullptr,
+            "Show the pending frame after the current one"),
+    COMMAND(cmd_frame_info, "info", nullptr, "Print point arena usage"),
+};
+
+void cmd_frame(SerialCommands &sender, Args &args) {
+  sender.listAllCommands(frame_commands,
+                         sizeof(frame_commands) / sizeof(Command));
+}
+
+#if ENABLE_PROFILER
+void cmd_stats_prof(SerialCommands &sender, Args &args) {
+  profiler.dump(sender.getSerial());
+}
+void cmd_stats_prof_reset(SerialCommands &sender, Args &args) {
+  profiler.reset();
+  sender.getSerial().println(F("Profiler reset"));
+}
+#endif
+
+// Defined further down - their sizes are needed for the memory report
+extern Command stats_commands[];
+extern Command commands[];
+extern const size_t stats_commands_size;
+extern const size_t commands_size;
+extern SerialCommands serialCommands;
+
+void cmd_stats_mem(SerialCommands &sender, Args &args) {
+  Stream &out = sender.getSerial();
+
+  mem_print_usage(out);
+
+  // Compile-time budget from config.h, for comparison
+  mem_print_row(out, F("budget_static"), mem_budget::total_bytes);
+  mem_print_row(out, F("budget_stack"), STACK_RESERVE);
+  mem_print_row(out, F("max_points"), MAX_POINTS);
+
+  // Major statics
+  mem_print_row(out, F("config"), sizeof(g_config));
+  mem_print_row(out, F("renderer"), sizeof(renderer));
+  mem_print_row(out, F("point_arena"), sizeof(point_arena_t));
+  mem_print_row(out, F("step_ring"), sizeof(step_ring_buf_16_t));
+  mem_print_row(out, F("hardware"), sizeof(Hardware::context));
+  mem_print_row(out, F("cmd_tables"),
+                sizeof(set_commands) + sizeof(reload_commands) +
+                    sizeof(frame_commands) + stats_commands_size +
+                    commands_size);
+  mem_print_row(out, F("serial_cmd"), sizeof(serialCommands));
+#if ENABLE_TRACE
+  mem_print_row(out, F("trace"), sizeof(trace));
+#endif
+#if ENABLE_PROFILER
+  mem_print_row(out, F("profiler"), sizeof(profiler));
+#endif
+
+  out.println(F("EOC"));
+}
+
+Command stats_commands[]{
+    COMMAND(cmd_stats_mem, "mem", nullptr, "Print SRAM usage"),
+#if ENABLE_PROFILER
+    COMMAND(cmd_stats_prof, "prof", nullptr, "Dump the profiler zone table"),
+    COMMAND(cmd_stats_prof_reset, "prof_reset", nullptr,
+            "Reset the profiler zone table"),
+#endif
+};
+const size_t stats_commands_size = sizeof(stats_commands);
+
+void cmd_stats(SerialCommands &sender, Args &args) {
+  sender.listAllCommands(stats_commands,
+                         sizeof(stats_commands) / sizeof(Command));
+}
+
+#if ENABLE_TRACE
+void cmd_trace_start(SerialCommands &sender, Args &args) {
+  trace.streaming = true;
+  sender.getSerial().println(F("Trace streaming started"));
+}
+void cmd_trace_stop(SerialCommands &sender, Args &args) {
+  trace.streaming = false;
+  sender.getSerial().println(F("Trace streaming stopped"));
+}
+void cmd_trace_clear(SerialCommands &sender, Args &args) {
+  trace.clear();
+  sender.getSerial().println(F("Trace cleared"));
+}
+void cmd_trace_mask(SerialCommands &sender, Args &args) {
+  trace.mask = args[0].getInt();
+  sender.getSerial().print(F("Trace mask set to "));
+  sender.getSerial().println(trace.mask, HEX);
+}
+
+Command trace_commands[]{
+    COMMAND(cmd_trace_start, "start", nullptr, "Start streaming trace records"),
+    COMMAND(cmd_trace_stop, "stop", nullptr, "Stop streaming trace records"),
+    COMMAND(cmd_trace_clear, "clear", nullptr, "Discard buffered records"),
+    COMMAND(cmd_trace_mask, "mask", arg_u16, nullptr,
+            "Set the enabled event mask (bit per event ID)"),
+};
+
+void cmd_trace(SerialCommands &sender, Args &args) {
+  sender.listAllCommands(trace_commands,
+                         sizeof(trace_commands) / sizeof(Command));
+}
+#endif
+
+// Scale (1/64ths), rotation (256 per turn) and offset (coord8) of the
+// displayed content, applied from the next frame
+void cmd_xform(SerialCommands &sender, Args &args) {
+  g_config.renderer.transform_scale = args[0].getInt();
+  g_config.renderer.transform_angle = args[1].getInt();
+  g_config.renderer.transform_x = args[2].getInt();
+  g_config.renderer.transform_y = args[3].getInt();
+  renderer.update_transform();
+  sender.getSerial().println(F("OK"));
+}
+
+#if ENABLE_GRID
+// Writes one correction grid node (column, row, x/y offset in DAC counts) to
+// EEPROM. Nodes not written yet are 0 - on an unwritten EEPROM they are
+// zeroed over the next loop passes, and the grid applies once that is done.
+void cmd_grid(SerialCommands &sender, Args &args) {
+  uint8_t col = args[0].getInt();
+  uint8_t row = args[1].getInt();
+  grid_set_node(col, row,
+                {(int16_t)args[2].getInt(), (int16_t)args[3].getInt()});
+  renderer.update_grid();
+
+  grid_node_t node = grid_get_node(col, row);
+  sender.getSerial().print(F("Grid node "));
+  sender.getSerial().print(col);
+  sender.getSerial().print(F(" "));
+  sender.getSerial().print(row);
+  sender.getSerial().print(F(" set to "));
+  sender.getSerial().print(node.x);
+  sender.getSerial().print(F(" "));
+  sender.getSerial().println(node.y);
+}
+#endif
+
 Command commands[]{
     COMMAND(cmd_help, "help", nullptr, "Prints this help message"),
     COMMAND(cmd_reset, "reset", nullptr, "Resets the device"),
     COMMAND(cmd_set, "set", set_commands, "Sets a parameter"),
     COMMAND(cmd_reload, "reload", reload_commands, "Reloads a parameter"),
+    COMMAND(cmd_frame, "frame", frame_commands, "Uploads point frames"),
+    COMMAND(cmd_xform, "xform", arg_u8, arg_u8, arg_offset, arg_offset,
+            nullptr, "Scale, rotate and offset the output"),
+#if ENABLE_GRID
+    COMMAND(cmd_grid, "grid", arg_grid_node, arg_grid_node, arg_grid_offset,
+            arg_grid_offset, nullptr, "Set a correction grid node offset"),
+#endif
+    COMMAND(cmd_stats, "stats", stats_commands, "Prints runtime statistics"),
+#if ENABLE_TRACE
+    COMMAND(cmd_trace, "trace", trace_commands, "Binary event trace"),
+#endif
 };
+const size_t commands_size = sizeof(commands);
+
+static_assert(sizeof(set_commands) + sizeof(reload_commands) +
+                      sizeof(frame_commands) + sizeof(stats_commands) +
+                      sizeof(commands)
+#if ENABLE_TRACE
+                      + sizeof(trace_commands)
+#endif
+                  <= SERIAL_CMD_MAX_COMMANDS * SERIAL_CMD_ENTRY_SIZE,
+              "Command tables exceed their memory budget in config.h");
+
+char serial_cmd_buffer[SERIAL_CMD_BUFFER_SIZE];
 SerialCommands serialCommands(Serial, commands,
-                              sizeof(commands) / sizeof(Command));
+                              sizeof(commands) / sizeof(Command),
+                              serial_cmd_buffer, sizeof(serial_cmd_buffer));
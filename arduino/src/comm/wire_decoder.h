@@ -0,0 +1,174 @@
+#pragma once
+#include "../debug.h"
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * FRAME WIRE ENCODING
+ * ============================================================================
+ *
+ * Compact upload format for 'frame data', sent as hex in one or more chunks
+ * after 'frame begin'. The encoder lives in python/serialio/wire.py.
+ *
+ *   x y flags                 first point, absolute (3 bytes)
+ *   then one record per point or run:
+ *
+ *   varint(zz(dx) << 2 | 0) varint(zz(dy))          point, same flags
+ *   varint(zz(dx) << 2 | 1) varint(zz(dy)) flags    point, new flags
+ *   varint(count << 2 | 2)                          previous point repeated
+ *
+ * varint is little endian base 128 (at most WIRE_VARINT_MAX_BYTES bytes),
+ * zz() is zigzag - 0, -1, 1, -2 ... -> 0, 1, 2, 3 ... Deltas wrap modulo 256.
+ * Runs are how blanked dwell/repeat points are sent.
+ *
+ * The decoder is fed a byte at a time, so records can be split across
+ * chunks freely.
+ *
+ * ============================================================================
+ */
+
+#define WIRE_KIND_POINT 0
+#define WIRE_KIND_POINT_FLAGS 1
+#define WIRE_KIND_REPEAT 2
+#define WIRE_KIND_MASK 0x03
+#define WIRE_VARINT_MAX_BYTES 2
+
+enum wire_result_t : uint8_t {
+  WIRE_NEED_MORE, // Record incomplete
+  WIRE_POINTS,    // point is ready, repeated count times
+  WIRE_ERROR,     // Malformed stream - reset before use
+};
+
+class WireDecoder {
+public:
+  point_coord8_t point; // Last decoded point
+  uint8_t count;        // Times to emit point on WIRE_POINTS
+
+  inline void reset() {
+    stage = STAGE_FIRST_X;
+    point = point_coord8_t();
+    count = 0;
+    varint = 0;
+    varint_bytes = 0;
+    kind = 0;
+    dx = 0;
+  }
+
+  WireDecoder() { reset(); }
+
+  wire_result_t feed(uint8_t byte) {
+    switch (stage) {
+    case STAGE_FIRST_X:
+      point.x = byte;
+      stage = STAGE_FIRST_Y;
+      return WIRE_NEED_MORE;
+
+    case STAGE_FIRST_Y:
+      point.y = byte;
+      stage = STAGE_FIRST_FLAGS;
+      return WIRE_NEED_MORE;
+
+    case STAGE_FIRST_FLAGS:
+      point.flags = byte;
+      stage = STAGE_HEAD;
+      return emit(1);
+
+    case STAGE_HEAD:
+      if (!read_varint(byte)) {
+        return varint_bytes ? WIRE_NEED_MORE : WIRE_ERROR;
+      }
+      kind = varint & WIRE_KIND_MASK;
+      if (kind == WIRE_KIND_REPEAT) {
+        uint16_t run = varint >> 2;
+        if (run == 0 || run > 255) {
+          return WIRE_ERROR;
+        }
+        return emit(run);
+      }
+      if (kind != WIRE_KIND_POINT && kind != WIRE_KIND_POINT_FLAGS) {
+        return WIRE_ERROR;
+      }
+      dx = unzigzag(varint >> 2);
+      stage = STAGE_DY;
+      return WIRE_NEED_MORE;
+
+    case STAGE_DY:
+      if (!read_varint(byte)) {
+        return varint_bytes ? WIRE_NEED_MORE : WIRE_ERROR;
+      }
+      point.x += dx;
+      point.y += unzigzag(varint);
+      if (kind == WIRE_KIND_POINT_FLAGS) {
+        stage = STAGE_FLAGS;
+        return WIRE_NEED_MORE;
+      }
+      stage = STAGE_HEAD;
+      return emit(1);
+
+    case STAGE_FLAGS:
+      point.flags = byte;
+      stage = STAGE_HEAD;
+      return emit(1);
+    }
+    return WIRE_ERROR;
+  }
+
+private:
+  enum stage_t : uint8_t {
+    STAGE_FIRST_X,
+    STAGE_FIRST_Y,
+    STAGE_FIRST_FLAGS,
+    STAGE_HEAD,
+    STAGE_DY,
+    STAGE_FLAGS,
+  };
+
+  stage_t stage;
+  uint16_t varint;
+  uint8_t varint_bytes; // Bytes of the current varint read so far
+  uint8_t kind;
+  int8_t dx;
+
+  inline wire_result_t emit(uint8_t n) {
+    count = n;
+    return WIRE_POINTS;
+  }
+
+  // Accumulates one varint byte - true once the varint is complete. On
+  // false, varint_bytes is 0 if the varint was too long.
+  inline bool read_varint(uint8_t byte) {
+    if (varint_bytes == 0) {
+      varint = 0;
+    }
+    varint |= (uint16_t)(byte & 0x7F) << (7 * varint_bytes);
+    varint_bytes++;
+
+    if (byte & 0x80) {
+      if (varint_bytes == WIRE_VARINT_MAX_BYTES) {
+        varint_bytes = 0;
+      }
+      return false;
+    }
+    varint_bytes = 0;
+    return true;
+  }
+
+  static inline int8_t unzigzag(uint16_t v) {
+    return (int8_t)((v >> 1) ^ -(int16_t)(v & 1));
+  }
+};
+
+// Hex digit value, or 0xFF if c is not a hex digit
+inline uint8_t hex_nibble(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return 0xFF;
+}
@@ -17,6 +17,10 @@
 // DEBUG CONFIGURATION
 // ============================================================================
 
+// ENABLE_TRACE / ENABLE_PROFILER live in debug.h - the memory budget below
+// needs to know whether they are compiled in
+#include "debug.h"
+
 // ============================================================================
 // SYSTEM CONSTANTS
 // ============================================================================
@@ -30,9 +34,10 @@
 // ============================================================================
 
 // Pin assignments
-#define LASER_PIN 9     // Laser control pin
-#define DEBUG_ISR_PIN 3 // ISR timing debug pin
-#define DEBUG_DAC_PIN 4 // DAC output debug pin
+#define LASER_PIN 9       // Laser control pin
+#define LASER_TIMER_PIN 9 // OC1A - laser pin in LASER_MODE_TIMER
+#define DEBUG_ISR_PIN 3   // ISR timing debug pin
+#define DEBUG_DAC_PIN 4   // DAC output debug pin
 
 // SPI configuration
 #define SPI_SPEED 20000000 // SPI clock speed (Hz)
@@ -71,10 +76,27 @@
 // ============================================================================
 
 // Main point buffer
+// MAX_POINTS is the frame size guaranteed when the displayed and pending
+// frames are the same length. Both share one arena, so a single frame can use
+// whatever the other one leaves free (up to MAX_FRAME_POINTS).
+// With AUTO_MAX_POINTS the arena gets whatever the memory budget below leaves
+// over, so it shrinks to make room for trace and profiler buffers. Set it to
+// 0 to fix MAX_POINTS instead.
+#define AUTO_MAX_POINTS 1
+#if AUTO_MAX_POINTS
+#define MAX_POINTS (mem_budget::auto_max_points) // Largest that fits
+#define MAX_BUFFER_INDEX (MAX_POINTS + 1)        // Maximum buffer index
+#else
 #define MAX_BUFFER_INDEX 64               // Maximum buffer index
 #define MAX_POINTS (MAX_BUFFER_INDEX - 1) // Maximum points per buffer
+#endif
+#define POINT_BUFFER_COUNT 2              // Displayed + pending frame
+#define POINT_ARENA_SIZE (POINT_BUFFER_COUNT * MAX_POINTS * 3) // Bytes
+#define MAX_FRAME_POINTS                                                       \
+  (POINT_ARENA_SIZE / 3 > 255 ? 255 : POINT_ARENA_SIZE / 3) // 8 bit counts
 #define MIN_POINTS 1                      // Minimum points per buffer
-#define DEFAULT_POINTS 64                 // Default points per buffer
+#define DEFAULT_POINTS                                                         \
+  (MAX_POINTS < 64 ? MAX_POINTS : 64) // Default points per buffer
 
 // Step ring buffer (hardcoded to 16 for bitwise operations)
 #define STEP_RING_BUFFER_SIZE 16 // Step ring buffer size (must be 2^n)
@@ -82,6 +104,26 @@
 #define MIN_STEP_BUFFER_SIZE 1   // Minimum step buffer size
 #define MAX_STEP_BUFFER_SIZE 16  // Maximum step buffer size
 
+// Event trace ring (see diagnostics/trace.h, only allocated if ENABLE_TRACE)
+#define TRACE_BUFFER_SIZE 16 // Trace records (must be 2^n, 6 bytes each)
+#define TRACE_BUFFER_MASK 15 // Bit mask for modulo operations (size-1)
+
+// Step cache (see renderer/buffers.h) - replays the steps of a repeating
+// frame instead of interpolating them again. Only a pass of up to
+// STEP_CACHE_STEPS steps is cached and its RAM comes out of the point arena,
+// so it is off unless a show is made of small frames. 'stats prof' gives
+// the hit rate (pass_replay calls against frame_pass calls).
+#define ENABLE_STEP_CACHE 0
+#define STEP_CACHE_STEPS 64 // Steps per cached pass, 4 bytes each
+
+// Optional features. Their state and command table entries come out of the
+// point arena too, so they are left out of the default build to keep
+// MAX_POINTS at 63 or more. Settings in g_config stay either way.
+#define ENABLE_EMPHASIS 0      // Per-axis pre-emphasis filter ('set emphasis')
+#define ENABLE_GRID 0          // Correction grid ('grid', 'set grid_correction')
+#define ENABLE_PROGRAMS 0      // Display list frames ('frame begin_prog')
+#define ENABLE_FRAME_SUMMARY 0 // Step count and time after 'frame commit'
+
 // ============================================================================
 // TIMING AND FREQUENCY LIMITS
 // ============================================================================
@@ -99,6 +141,36 @@
 #define MAX_DWELL_TIME 255     // Maximum dwell time
 #define DEFAULT_DWELL_TIME 5   // Default dwell time
 
+// Pre-emphasis gain (see renderer/emphasis.h), 1/16ths - 0 = off
+#define DEFAULT_EMPHASIS 0
+
+// Laser output modes (see hardware/laser.h)
+#define LASER_MODE_GPIO 0  // Pin written by the ISR
+#define LASER_MODE_TIMER 1 // OC1A switched by Timer1 at edge_offset
+#define DEFAULT_LASER_MODE LASER_MODE_GPIO
+// Must be later than the ISR's DAC writes, or the edge slips a period
+#define DEFAULT_LASER_EDGE_OFFSET 320 // Timer ticks (20us at 16MHz)
+
+// Laser delay line (steps) - shifts the laser bit against the positions in
+// the step ring, + = laser switches later, - = earlier
+#define DEFAULT_LASER_DELAY 0
+#define MAX_LASER_DELAY 8 // Either way - leading is limited by the ring fill
+
+// Adaptive dwell curves (see renderer/dwell.h), dwell steps at evenly spaced
+// turn angles / jump lengths
+#define DWELL_CURVE_POINTS 9
+#define DEFAULT_CORNER_DWELL {0, 0, 0, 1, 2, 3, 4, 5, 6} // 0..180 degrees
+#define DEFAULT_JUMP_DWELL {1, 2, 3, 4, 5, 5, 6, 7, 8}   // 0..256 coord8
+
+// Geometric correction grid (see renderer/grid.h) - kept in EEPROM
+#define GRID_EEPROM_ADDRESS 0
+#define DEFAULT_GRID_CORRECTION false
+
+// Safety zone (see renderer/zone.h), coord8 bounds - inclusive
+#define DEFAULT_ZONE_ENABLED false
+#define DEFAULT_ZONE_MIN 0
+#define DEFAULT_ZONE_MAX 255
+
 // ============================================================================
 // INTERPOLATION PARAMETERS
 // ============================================================================
@@ -117,6 +189,12 @@
 #define MAX_DEC_FACTOR 7     // Maximum deceleration factor
 #define DEFAULT_DEC_FACTOR 4 // Default deceleration factor
 
+// Blanked travel - moves with the laser off at both ends are not drawn, so
+// they get their own, faster profile
+#define DEFAULT_BLANK_STEP_SIZE 32 // Default blanked step size
+#define DEFAULT_BLANK_ACC_FACTOR 0 // Default blanked acceleration factor
+#define DEFAULT_BLANK_DEC_FACTOR 2 // Default blanked deceleration factor
+
 // ============================================================================
 // SERIAL COMMUNICATION
 // ============================================================================
@@ -127,6 +205,13 @@
 #define DEFAULT_BAUD_RATE 9600        // Default baud rate
 #define SERIAL_BAUD DEFAULT_BAUD_RATE // Alias for compatibility
 
+// StaticSerialCommands
+#define SERIAL_CMD_BUFFER_SIZE 64  // Command line buffer (bytes)
+#define SERIAL_CMD_MAX_COMMANDS                                                \
+  (48 + ENABLE_EMPHASIS + ENABLE_GRID * 2 + ENABLE_PROGRAMS +                 \
+   ENABLE_TRACE * 5 + ENABLE_PROFILER * 2) // Entries across all command tables
+#define SERIAL_CMD_ENTRY_SIZE 14   // Budgeted sizeof(Command) on AVR
+
 // ============================================================================
 // SYSTEM LIMITS AND VALIDATION
 // ============================================================================
@@ -140,6 +225,99 @@
 #define MAX_MEMORY_USAGE 2048 // Maximum expected memory usage (bytes)
 #define MIN_FREE_MEMORY 100   // Minimum free memory threshold (bytes)
 
+// ============================================================================
+// MEMORY BUDGET
+// ============================================================================
+
+/*
+ * Compile-time SRAM budget. Sums the static footprint of everything sized in
+ * this file and fails the build if it does not leave STACK_RESERVE free.
+ * Use 'stats mem' on a running unit to check the reserves are honest -
+ * stack_peak should stay below STACK_RESERVE.
+ *
+ * Sizes that depend on types defined elsewhere are checked against these
+ * numbers with static_asserts next to the types themselves. STATE_RAM_RESERVE
+ * is the exception - its objects hold pointers, so only 'stats mem' on the
+ * target gives their real size.
+ */
+
+#define BOARD_SRAM_SIZE MAX_MEMORY_USAGE // Target board SRAM (bytes)
+#define STACK_RESERVE 384        // Kept free for the stack and ISR frames
+#define CORE_RAM_RESERVE 48      // Arduino core, HardwareSerial state, SPI
+#define CONFIG_RAM_RESERVE 64    // g_config
+// Renderer less its point arena and step ring
+#define RENDERER_RAM_RESERVE                                                   \
+  (88 + ENABLE_EMPHASIS * 6 + ENABLE_GRID + ENABLE_PROGRAMS * 19 +             \
+   ENABLE_FRAME_SUMMARY * 13 + ENABLE_PROFILER * 4)
+// interp, hardware context, show, wire decoder, SerialCommands and the grid
+// cell
+#define STATE_RAM_RESERVE (112 + ENABLE_GRID * 24)
+#define PROFILE_ZONE_RESERVE 8   // Profiler zones budgeted
+
+#ifndef SERIAL_RX_BUFFER_SIZE
+#define SERIAL_RX_BUFFER_SIZE 64
+#endif
+#ifndef SERIAL_TX_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_SIZE 64
+#endif
+
+namespace mem_budget {
+
+// point_arena_t: the arena plus two frame regions, a flag and the delta
+// append cursor (rounded up)
+constexpr uint16_t arena_overhead_bytes = 32;
+constexpr uint16_t point_arena_bytes(uint16_t points) {
+  return POINT_BUFFER_COUNT * points * 3 + arena_overhead_bytes;
+}
+
+// step_ring_buf_16_t: Q12.4 point per step, flag bits, head and tail, laser
+// delay and its history (rounded up)
+constexpr uint16_t step_ring_bytes = STEP_RING_BUFFER_SIZE * 4 + 2 + 2 + 4;
+
+// Core serial buffers plus the command line buffer and tables
+constexpr uint16_t protocol_bytes =
+    SERIAL_RX_BUFFER_SIZE + SERIAL_TX_BUFFER_SIZE + SERIAL_CMD_BUFFER_SIZE +
+    SERIAL_CMD_MAX_COMMANDS * SERIAL_CMD_ENTRY_SIZE;
+
+// TraceRing: 6 byte records plus mask, flags, indices and drop count
+constexpr uint16_t trace_bytes = ENABLE_TRACE ? TRACE_BUFFER_SIZE * 6 + 8 : 0;
+
+// step_cache_t: 4 bytes per step plus counts, state and the renderer config
+// it was recorded with (rounded up)
+constexpr uint16_t step_cache_bytes =
+    ENABLE_STEP_CACHE ? STEP_CACHE_STEPS * 4 + 48 : 0;
+
+// Profiler: 12 bytes per zone
+constexpr uint16_t profiler_bytes =
+    ENABLE_PROFILER ? PROFILE_ZONE_RESERVE * 12 : 0;
+
+// Everything except the point buffers
+constexpr uint16_t fixed_bytes =
+    step_ring_bytes + step_cache_bytes + protocol_bytes + trace_bytes +
+    profiler_bytes + CORE_RAM_RESERVE + CONFIG_RAM_RESERVE + RENDERER_RAM_RESERVE +
+    STATE_RAM_RESERVE;
+
+constexpr uint16_t available_bytes = BOARD_SRAM_SIZE - STACK_RESERVE;
+
+static_assert(fixed_bytes + point_arena_bytes(MIN_POINTS) <= available_bytes,
+              "Memory budget: fixed buffers leave no room for points");
+
+// Largest point count that fits - capped by the 8 bit buffer indices
+constexpr uint16_t fit_points =
+    (available_bytes - fixed_bytes - arena_overhead_bytes) /
+    (POINT_BUFFER_COUNT * 3);
+constexpr uint8_t auto_max_points = fit_points > 255 ? 255 : fit_points;
+
+constexpr uint16_t point_bytes = point_arena_bytes(MAX_POINTS);
+
+constexpr uint16_t total_bytes = fixed_bytes + point_bytes;
+
+static_assert(total_bytes <= available_bytes,
+              "Memory budget: buffers exceed SRAM - STACK_RESERVE. Reduce "
+              "MAX_POINTS or set AUTO_MAX_POINTS");
+
+} // namespace mem_budget
+
 // ============================================================================
 // LEGACY COMPATIBILITY
 // ============================================================================
@@ -165,20 +343,43 @@ struct config_t {
 
   struct laser_config_t {
     uint8_t pin;
+    int8_t delay;         // Steps, see DEFAULT_LASER_DELAY
+    uint8_t mode;         // LASER_MODE_*
+    uint16_t edge_offset; // LASER_MODE_TIMER: ticks into the period
   } laser;
 
-  struct {
+  struct renderer_config_t {
     uint8_t laser_on_dwell;
     uint8_t laser_off_dwell;
     uint8_t max_step_size; // 0 = no interpolation
     uint8_t acc_factor;    // 0 = no acceleration
     uint8_t dec_factor;    // 0 = no deceleration
+    uint8_t blank_step_size;  // Blanked moves: 0 = no interpolation
+    uint8_t blank_acc_factor; // Blanked moves: 0 = no acceleration
+    uint8_t blank_dec_factor; // Blanked moves: 0 = no deceleration
+    uint8_t corner_dwell[DWELL_CURVE_POINTS]; // By lit turn angle
+    uint8_t jump_dwell[DWELL_CURVE_POINTS];   // By blanked jump length
+    uint8_t emphasis_x; // Pre-emphasis gain in 1/16ths, 0 = off
+    uint8_t emphasis_y;
+    uint8_t transform_scale; // 1/64ths (see renderer/transform.h)
+    uint8_t transform_angle; // 256 per turn, anticlockwise
+    int8_t transform_x;      // Offset, coord8 units
+    int8_t transform_y;
     bool flip_x;
     bool flip_y;
     bool swap_xy;
+    bool grid_correction; // Apply the EEPROM correction grid
+    bool zone_enabled;    // Only light the laser inside the safety zone
+    uint8_t zone_x_min;   // Safety zone, coord8 after the transform
+    uint8_t zone_y_min;
+    uint8_t zone_x_max;
+    uint8_t zone_y_max;
   } renderer;
 };
 
+static_assert(sizeof(config_t) <= CONFIG_RAM_RESERVE,
+              "config_t exceeds CONFIG_RAM_RESERVE");
+
 const config_t default_config = {
     .timer =
         {
@@ -201,6 +402,9 @@ const config_t default_config = {
     .laser =
         {
             .pin = LASER_PIN,
+            .delay = DEFAULT_LASER_DELAY,
+            .mode = DEFAULT_LASER_MODE,
+            .edge_offset = DEFAULT_LASER_EDGE_OFFSET,
         },
     .renderer =
         {
@@ -209,9 +413,26 @@ const config_t default_config = {
             .max_step_size = DEFAULT_STEP_SIZE,
             .acc_factor = DEFAULT_ACC_FACTOR,
             .dec_factor = DEFAULT_DEC_FACTOR,
+            .blank_step_size = DEFAULT_BLANK_STEP_SIZE,
+            .blank_acc_factor = DEFAULT_BLANK_ACC_FACTOR,
+            .blank_dec_factor = DEFAULT_BLANK_DEC_FACTOR,
+            .corner_dwell = DEFAULT_CORNER_DWELL,
+            .jump_dwell = DEFAULT_JUMP_DWELL,
+            .emphasis_x = DEFAULT_EMPHASIS,
+            .emphasis_y = DEFAULT_EMPHASIS,
+            .transform_scale = 64,
+            .transform_angle = 0,
+            .transform_x = 0,
+            .transform_y = 0,
             .flip_x = false,
             .flip_y = false,
             .swap_xy = false,
+            .grid_correction = DEFAULT_GRID_CORRECTION,
+            .zone_enabled = DEFAULT_ZONE_ENABLED,
+            .zone_x_min = DEFAULT_ZONE_MIN,
+            .zone_y_min = DEFAULT_ZONE_MIN,
+            .zone_x_max = DEFAULT_ZONE_MAX,
+            .zone_y_max = DEFAULT_ZONE_MAX,
         },
 
 };
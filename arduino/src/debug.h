@@ -23,6 +23,7 @@
  * IMPORTANT WARNINGS:
  * - NEVER use Serial debug macros inside ISRs (Timer, SPI, etc.)
  * - Use DEBUG_ISR_START/END() for ISR timing instead
+ * - Use TRACE_EVENT() (diagnostics/trace.h) for events in ISRs or hot paths
  * - Debug strings are stored in PROGMEM to save RAM
  * - Validation macros can be compiled out completely in production
  * - Performance monitoring adds overhead - use only in development
@@ -69,6 +70,8 @@
  * PERFORMANCE MACROS:
  *   DEBUG_PERF_START()            - Start performance timing
  *   DEBUG_PERF_END(label)         - End timing and print duration
+ *   PROFILE_ZONE(zone)            - Silent, always-on timing of a scope
+ *                                   (diagnostics/profiler.h)
  *   DEBUG_MEM_USAGE(label)        - Print free RAM
  *
  * UTILITY MACROS:
@@ -88,6 +91,9 @@
 
 #define ENABLE_DEBUG_PINS 1
 
+#define ENABLE_TRACE 0    // Binary event trace ring (diagnostics/trace.h)
+#define ENABLE_PROFILER 0 // Profiler zone table (diagnostics/profiler.h)
+
 #define DEBUG_LEVEL 0 // 0=silent, 1=errors, 2=info, 3=verbose
 
 // Debug level constants
@@ -0,0 +1,41 @@
+#pragma once
+#include "../config.h"
+#include <Arduino.h>
+
+/*
+ * Cheap timestamps for diagnostics
+ *
+ * Reads Timer0 directly (already free running at /64 for millis/micros)
+ * instead of calling micros(), so a timestamp costs a handful of cycles and
+ * is safe inside ISRs.
+ *
+ * 1 tick = 64 CPU cycles = 4us at 16MHz
+ */
+
+#define CLOCK_TICK_CYCLES 64 // CPU cycles per clock tick (Timer0 prescaler)
+#define CLOCK_TICK_US (CLOCK_TICK_CYCLES / (CLOCK_FREQ / 1000000))
+
+// Maintained by the Arduino core (wiring.c)
+extern "C" volatile unsigned long timer0_overflow_count;
+
+// Must be called with interrupts disabled
+inline uint32_t clock_ticks_unlocked() {
+  uint32_t m = timer0_overflow_count;
+  uint8_t t = TCNT0;
+
+  // Overflow pending but not yet serviced - count it ourselves
+  if ((TIFR0 & _BV(TOV0)) && t < 255) {
+    m++;
+  }
+
+  return (m << 8) | t;
+}
+
+// Full 32 bit tick count - wraps after ~4.7 hours
+inline uint32_t clock_ticks() {
+  uint8_t sreg = SREG;
+  cli();
+  uint32_t ticks = clock_ticks_unlocked();
+  SREG = sreg;
+  return ticks;
+}
@@ -0,0 +1,80 @@
+#include "memory.h"
+
+// Linker and avr-libc symbols
+extern uint8_t __data_start;
+extern uint8_t __bss_end;
+extern uint8_t __heap_start;
+extern uint8_t _end;
+extern uint8_t __stack;
+extern "C" char *__brkval;
+
+// Runs from .init3: after the stack pointer is set up, before .data/.bss are
+// initialised and before any constructors. Must not use the stack.
+extern "C" void mem_paint_stack(void)
+    __attribute__((naked, used, section(".init3")));
+
+extern "C" void mem_paint_stack(void) {
+  uint8_t *p = &_end;
+  while (p <= &__stack) {
+    *p = MEM_STACK_CANARY;
+    p++;
+  }
+}
+
+static inline uint8_t *heap_end() {
+  return __brkval ? (uint8_t *)__brkval : &__heap_start;
+}
+
+uint16_t mem_free_ram() {
+  uint8_t *sp = (uint8_t *)SP;
+  uint8_t *heap = heap_end();
+  return sp > heap ? (uint16_t)(sp - heap) : 0;
+}
+
+void mem_get_usage(mem_usage_t *usage) {
+  uint8_t *heap = heap_end();
+  uint8_t *sp = (uint8_t *)SP;
+
+  // First byte above the heap that has been overwritten
+  uint8_t *p = heap;
+  while (p <= &__stack && *p == MEM_STACK_CANARY) {
+    p++;
+  }
+
+  usage->total = RAMEND - RAMSTART + 1;
+  usage->statics = &__bss_end - &__data_start;
+  usage->heap = heap - &__heap_start;
+  usage->free_now = sp > heap ? (uint16_t)(sp - heap) : 0;
+  usage->free_min = p - heap;
+  usage->stack_now = &__stack - sp;
+  usage->stack_peak = &__stack - p + 1;
+  usage->used_peak = usage->statics + usage->heap + usage->stack_peak;
+}
+
+void mem_print_row(Stream &out, const __FlashStringHelper *name,
+                   uint16_t bytes) {
+  out.print(name);
+  out.print(F(" "));
+  out.println(bytes);
+}
+
+void mem_print_usage(Stream &out) {
+  mem_usage_t usage;
+  mem_get_usage(&usage);
+
+  mem_print_row(out, F("ram_total"), usage.total);
+  mem_print_row(out, F("statics"), usage.statics);
+  mem_print_row(out, F("heap"), usage.heap);
+  mem_print_row(out, F("stack_now"), usage.stack_now);
+  mem_print_row(out, F("stack_peak"), usage.stack_peak);
+  mem_print_row(out, F("free_now"), usage.free_now);
+  mem_print_row(out, F("free_min"), usage.free_min);
+  mem_print_row(out, F("used_peak"), usage.used_peak);
+
+  if (usage.free_min < MIN_FREE_MEMORY) {
+    out.println(F("WARN: free_min below MIN_FREE_MEMORY"));
+  }
+  if (usage.used_peak > MAX_MEMORY_USAGE) {
+    out.println(F("WARN: used_peak above MAX_MEMORY_USAGE"));
+  }
+}
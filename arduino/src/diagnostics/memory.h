@@ -0,0 +1,51 @@
+#pragma once
+#include "../config.h"
+#include "../debug.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * GALVONIUM SRAM TELEMETRY
+ * ============================================================================
+ *
+ * SRAM layout on the ATmega328P (2KB):
+ *
+ *   RAMSTART  .data | .bss | heap -> ...free... <- stack  RAMEND
+ *
+ * At boot (before constructors run) everything between the end of .bss and
+ * RAMEND is painted with MEM_STACK_CANARY. The stack high-water mark is found
+ * later by scanning up from the heap end for the first byte that is no longer
+ * the canary value - i.e. the deepest the stack has ever reached.
+ *
+ * 'stats mem' prints this along with the size of the major statics. Check it
+ * before (and after) growing any buffer.
+ *
+ * ============================================================================
+ */
+
+#define MEM_STACK_CANARY 0xC5
+
+struct mem_usage_t {
+  uint16_t total;        // Total SRAM (bytes)
+  uint16_t statics;      // .data + .bss (bytes)
+  uint16_t heap;         // malloc heap in use (bytes)
+  uint16_t free_now;     // Gap between heap and stack right now (bytes)
+  uint16_t free_min;     // Smallest gap ever seen, from the stack paint
+  uint16_t stack_now;    // Current stack depth (bytes)
+  uint16_t stack_peak;   // Deepest stack ever seen (bytes)
+  uint16_t used_peak;    // statics + heap + stack_peak (bytes)
+};
+
+// Current gap between the top of the heap and the stack pointer
+uint16_t mem_free_ram();
+
+// Scan the stack paint and fill in a full usage snapshot
+void mem_get_usage(mem_usage_t *usage);
+
+// Print a "name bytes" row - used by the 'stats mem' report
+void mem_print_row(Stream &out, const __FlashStringHelper *name,
+                   uint16_t bytes);
+
+// Print the usage snapshot - warns below MIN_FREE_MEMORY or above
+// MAX_MEMORY_USAGE
+void mem_print_usage(Stream &out);
@@ -0,0 +1,61 @@
+#include "profiler.h"
+
+#if ENABLE_PROFILER
+
+Profiler profiler;
+
+static const char zone_loop[] PROGMEM = "loop";
+static const char zone_render_process[] PROGMEM = "render_process";
+static const char zone_serial_read[] PROGMEM = "serial_read";
+static const char zone_interp_init[] PROGMEM = "interp_init";
+static const char zone_buffer_swap[] PROGMEM = "buffer_swap";
+static const char zone_frame_compile[] PROGMEM = "frame_compile";
+static const char zone_frame_pass[] PROGMEM = "frame_pass";
+static const char zone_pass_replay[] PROGMEM = "pass_replay";
+
+static const char *const profile_zone_names[PROFILE_ZONE_COUNT] PROGMEM = {
+    zone_loop, zone_render_process, zone_serial_read, zone_interp_init,
+    zone_buffer_swap, zone_frame_compile, zone_frame_pass, zone_pass_replay,
+};
+
+void Profiler::reset() {
+  for (uint8_t i = 0; i < PROFILE_ZONE_COUNT; i++) {
+    zones[i].calls = 0;
+    zones[i].total = 0;
+    zones[i].min = 0xFFFF;
+    zones[i].max = 0;
+  }
+}
+
+void Profiler::dump(Stream &out) const {
+  // Share of loop() time is relative to the loop zone
+  uint32_t loop_total = zones[PROFILE_LOOP].total;
+
+  // Durations are in clock ticks, not cycles - the timer only counts every
+  // CLOCK_TICK_CYCLES cycles, so scaling them up would claim a resolution
+  // that is not there
+  out.println(F("zone calls total_ms min_t64 avg_t64 max_t64 loop_%"));
+
+  for (uint8_t i = 0; i < PROFILE_ZONE_COUNT; i++) {
+    const profile_zone_stats_t &z = zones[i];
+
+    out.print((const __FlashStringHelper *)pgm_read_ptr(
+        &profile_zone_names[i]));
+    out.print(F(" "));
+    out.print(z.calls);
+    out.print(F(" "));
+    out.print(z.total / (1000 / CLOCK_TICK_US));
+    out.print(F(" "));
+    out.print(z.calls ? z.min : 0);
+    out.print(F(" "));
+    out.print(z.calls ? z.total / z.calls : 0);
+    out.print(F(" "));
+    out.print(z.max);
+    out.print(F(" "));
+    out.println(loop_total >= 100 ? z.total / (loop_total / 100) : 0);
+  }
+
+  out.println(F("EOC"));
+}
+
+#endif
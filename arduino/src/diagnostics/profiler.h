@@ -0,0 +1,96 @@
+#pragma once
+#include "../config.h"
+#include "../debug.h"
+#include "clock.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * GALVONIUM PROFILER
+ * ============================================================================
+ *
+ * Always-on replacement for DEBUG_PERF_START/END. Each zone has a compile-time
+ * ID and accumulates call count, total, min and max duration into a fixed
+ * table - nothing is printed until the table is dumped with 'stats prof'.
+ *
+ * USAGE:
+ *   void Renderer::process() {
+ *     PROFILE_ZONE(PROFILE_RENDER_PROCESS);
+ *     ...
+ *   } // zone ends when the scope ends
+ *
+ * Durations come from clock.h and are reported in clock ticks of 64 cycles
+ * (4us at 16MHz) - the min/avg/max columns are named _t64 for that. A zone
+ * shorter than a tick reads 0 or 1. Only use zones in loop() context - not
+ * in ISRs.
+ *
+ * ============================================================================
+ */
+
+// Zone IDs - add new zones here and to profile_zone_names in profiler.cpp
+enum profile_zone_t : uint8_t {
+  PROFILE_LOOP,           // Whole of loop()
+  PROFILE_RENDER_PROCESS, // Renderer::process
+  PROFILE_SERIAL_READ,    // serialCommands.readSerial
+  PROFILE_INTERP_INIT,    // Interpolation setup for a new transition
+  PROFILE_BUFFER_SWAP,    // Point buffer swap
+  PROFILE_FRAME_COMPILE,  // Segment precompute when a frame is committed
+  PROFILE_FRAME_PASS,     // One pass of the displayed frame
+  PROFILE_PASS_REPLAY,    // A pass replayed from the step cache
+  PROFILE_ZONE_COUNT
+};
+
+static_assert(PROFILE_ZONE_COUNT <= PROFILE_ZONE_RESERVE,
+              "More profiler zones than PROFILE_ZONE_RESERVE in config.h");
+
+struct profile_zone_stats_t {
+  uint32_t calls;
+  uint32_t total; // clock ticks
+  uint16_t min;   // clock ticks
+  uint16_t max;   // clock ticks
+};
+
+class Profiler {
+public:
+  inline void record(uint8_t zone, uint32_t ticks) {
+    profile_zone_stats_t &z = zones[zone];
+    uint16_t t = ticks > 0xFFFF ? 0xFFFF : (uint16_t)ticks;
+
+    z.calls++;
+    z.total += ticks;
+    if (t < z.min) {
+      z.min = t;
+    }
+    if (t > z.max) {
+      z.max = t;
+    }
+  }
+
+  void reset();
+  void dump(Stream &out) const;
+
+  Profiler() { reset(); }
+
+private:
+  profile_zone_stats_t zones[PROFILE_ZONE_COUNT];
+};
+
+#if ENABLE_PROFILER
+extern Profiler profiler;
+
+// Records the lifetime of the enclosing scope against ZONE
+template <uint8_t ZONE> class ProfileScope {
+  static_assert(ZONE < PROFILE_ZONE_COUNT, "Unknown profiler zone");
+
+public:
+  inline ProfileScope() : start(clock_ticks()) {}
+  inline ~ProfileScope() { profiler.record(ZONE, clock_ticks() - start); }
+
+private:
+  uint32_t start;
+};
+
+#define PROFILE_ZONE(zone) ProfileScope<zone> _profile_scope_##zone
+#else
+#define PROFILE_ZONE(zone)
+#endif
@@ -0,0 +1,61 @@
+#include "trace.h"
+
+#if ENABLE_TRACE
+
+TraceRing trace;
+
+void TraceRing::clear() {
+  uint8_t sreg = SREG;
+  cli();
+  head = 0;
+  tail = 0;
+  dropped = 0;
+  SREG = sreg;
+}
+
+void TraceRing::write_frame(Stream &out, const trace_record_t &r) {
+  uint8_t frame[TRACE_FRAME_SIZE] = {
+      TRACE_SYNC_BYTE,       (uint8_t)r.timestamp, (uint8_t)(r.timestamp >> 8),
+      r.event,               r.a,                  (uint8_t)r.b,
+      (uint8_t)(r.b >> 8),   0};
+
+  uint8_t checksum = 0;
+  for (uint8_t i = 1; i < TRACE_FRAME_SIZE - 1; i++) {
+    checksum += frame[i];
+  }
+  frame[TRACE_FRAME_SIZE - 1] = checksum;
+
+  out.write(frame, TRACE_FRAME_SIZE);
+}
+
+void TraceRing::drain(Stream &out) {
+  if (!streaming) {
+    return;
+  }
+
+  // Report drops first so the host knows where the gap is
+  if (dropped && out.availableForWrite() >= TRACE_FRAME_SIZE) {
+    trace_record_t r;
+
+    uint8_t sreg = SREG;
+    cli();
+    r.timestamp = (uint16_t)clock_ticks_unlocked();
+    r.b = dropped;
+    dropped = 0;
+    SREG = sreg;
+
+    r.event = TRACE_EVT_OVERFLOW;
+    r.a = 0;
+    write_frame(out, r);
+  }
+
+  // Single consumer: the slot at tail is not touched by producers until tail
+  // moves past it, so it can be copied without disabling interrupts
+  while (tail != head && out.availableForWrite() >= TRACE_FRAME_SIZE) {
+    trace_record_t r = records[tail];
+    tail = (tail + 1) & TRACE_BUFFER_MASK;
+    write_frame(out, r);
+  }
+}
+
+#endif
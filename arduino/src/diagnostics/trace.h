@@ -0,0 +1,121 @@
+#pragma once
+#include "../config.h"
+#include "../debug.h"
+#include "../types.h"
+#include "clock.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * GALVONIUM EVENT TRACE
+ * ============================================================================
+ *
+ * Binary event ring for debugging timing problems without touching Serial in
+ * hot paths. TRACE_EVENT(id, a, b) stores a 6 byte record {timestamp, id, a, b}
+ * in a few dozen cycles and is safe to call from the timer ISR and from loop().
+ *
+ * trace.drain() is called from loop() and only writes whole frames while the
+ * serial TX buffer has room, so it never blocks the renderer.
+ *
+ * WIRE FORMAT (8 bytes per record, little endian):
+ *   0xA5, ts_lo, ts_hi, id, a, b_lo, b_hi, checksum
+ *   checksum = (ts_lo + ts_hi + id + a + b_lo + b_hi) & 0xFF
+ *   timestamp is in clock ticks (4us) and wraps every ~262ms
+ *
+ * Decode with python/serialio/trace.py. Keep the event IDs below in sync with
+ * TRACE_EVENTS there.
+ *
+ * Records are dropped (not overwritten) when the ring is full; the number of
+ * dropped records is reported as a TRACE_EVT_OVERFLOW record on the next drain.
+ *
+ * ============================================================================
+ */
+
+#define TRACE_SYNC_BYTE 0xA5
+#define TRACE_FRAME_SIZE 8
+
+// Event IDs - max 16 so each has a bit in the runtime mask
+enum trace_event_t {
+  TRACE_EVT_OVERFLOW = 0,       // b: records dropped
+  TRACE_EVT_STEP_POP = 1,       // a: laser, b: step ring size after pop
+  TRACE_EVT_STEP_PUSH = 2,      // a: laser, b: step ring size after push
+  TRACE_EVT_STEP_UNDERRUN = 3,  // ISR found the step ring empty
+  TRACE_EVT_TRANSITION = 4,     // a: laser states, b: end point (x << 8 | y)
+  TRACE_EVT_INTERP_INIT = 5,    // a: total steps, b: x step (Q12.4)
+  TRACE_EVT_DWELL = 6,          // a: dwell steps
+  TRACE_EVT_BUFFER_END = 7,     // a: point count, b: repeat count
+  TRACE_EVT_BUFFER_SWAP = 8,    // a: new point count
+  TRACE_EVT_RENDER_FAULT = 9,   // a: render state
+  TRACE_EVT_REPLAY = 10,        // b: cached steps replayed this pass
+  TRACE_EVT_USER = 15,          // free for ad hoc debugging
+};
+
+// Step push/pop fire on every sample - off unless asked for
+#define TRACE_DEFAULT_MASK                                                     \
+  (0xFFFF & ~(BIT_MASK(TRACE_EVT_STEP_POP) | BIT_MASK(TRACE_EVT_STEP_PUSH)))
+
+struct trace_record_t {
+  uint16_t timestamp;
+  uint8_t event;
+  uint8_t a;
+  uint16_t b;
+};
+
+class TraceRing {
+public:
+  uint16_t mask = TRACE_DEFAULT_MASK;
+  bool streaming = false;
+
+  // Producer - ISR or loop context
+  inline void record(uint8_t event, uint8_t a, uint16_t b) {
+    if (!(mask & BIT_MASK(event))) {
+      return;
+    }
+
+    uint8_t sreg = SREG;
+    cli();
+
+    uint8_t next = (head + 1) & TRACE_BUFFER_MASK;
+    if (next == tail) {
+      if (dropped != 0xFFFF) {
+        dropped++;
+      }
+      SREG = sreg;
+      return;
+    }
+
+    trace_record_t &r = records[head];
+    r.timestamp = (uint16_t)clock_ticks_unlocked();
+    r.event = event;
+    r.a = a;
+    r.b = b;
+    head = next;
+
+    SREG = sreg;
+  }
+
+  // Consumer - loop context only
+  void drain(Stream &out);
+  void clear();
+
+private:
+  trace_record_t records[TRACE_BUFFER_SIZE];
+  volatile uint8_t head = 0;
+  volatile uint8_t tail = 0;
+  volatile uint16_t dropped = 0;
+
+  void write_frame(Stream &out, const trace_record_t &r);
+};
+
+#if ENABLE_TRACE
+static_assert(sizeof(TraceRing) <= mem_budget::trace_bytes,
+              "TraceRing larger than its memory budget");
+
+extern TraceRing trace;
+#define TRACE_EVENT(event, a, b)                                               \
+  trace.record((event), (uint8_t)(a), (uint16_t)(b))
+#define TRACE_DRAIN(out) trace.drain(out)
+#else
+#define TRACE_EVENT(event, a, b)
+#define TRACE_DRAIN(out)
+#endif
@@ -51,7 +51,11 @@ public:
 
   void update_dac_from_config() { dac.init(); }
 
-  void update_laser_from_config() { laser.set_pin(g_config.laser.pin); }
+  void update_laser_from_config() {
+    timer.setLaserTiming(g_config.laser.mode == LASER_MODE_TIMER,
+                         g_config.laser.edge_offset);
+    laser.configure();
+  }
 
   void update_serial_from_config() { serial.init(); }
 
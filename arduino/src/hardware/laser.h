@@ -5,6 +5,19 @@
 // Laser control class
 // TODO: write directly to port registers instead of using digitalWrite
 
+/*
+Laser modes (g_config.laser.mode):
+
+LASER_MODE_GPIO - the pin is written from the timer ISR once the DAC writes
+are done, so edges move with the ISR's timing.
+
+LASER_MODE_TIMER - the laser is on OC1A (pin 9) and Timer1 switches it at
+g_config.laser.edge_offset ticks into each sample period (see Timer). The ISR
+only arms the compare output for the next edge - a register write instead of
+a digitalWrite. digitalWrite/digitalRead must not be used on the pin in this
+mode, they disconnect the compare output.
+*/
+
 class Laser {
 public:
   Laser() {
@@ -12,9 +25,25 @@ public:
   }
 
   void init() {
-    laser_pin = g_config.laser.pin;
+    timer_mode = g_config.laser.mode == LASER_MODE_TIMER;
+    laser_pin = timer_mode ? LASER_TIMER_PIN : g_config.laser.pin;
     pinMode(laser_pin, OUTPUT);
     digitalWrite(laser_pin, LOW);
+
+    if (timer_mode) {
+      // Connect OC1A and force it low straight away
+      arm(false);
+      TCCR1C = (1 << FOC1A);
+    }
+  }
+
+  // Release the current pin and apply g_config.laser
+  void configure() {
+    if (timer_mode) {
+      arm_disconnect();
+    }
+    pinMode(laser_pin, INPUT);
+    init();
   }
 
   void set_pin(uint8_t pin) {
@@ -25,6 +54,11 @@ public:
   }
 
   void set_laser(bool enable) {
+    if (timer_mode) {
+      arm(enable);
+      return;
+    }
+
     if (enable) {
       digitalWrite(laser_pin, HIGH);
     } else {
@@ -32,8 +66,24 @@ public:
     }
   }
 
-  bool is_laser_on() { return digitalRead(laser_pin) == HIGH; }
+  bool is_laser_on() {
+    if (timer_mode) {
+      return *portInputRegister(digitalPinToPort(laser_pin)) &
+             digitalPinToBitMask(laser_pin);
+    }
+    return digitalRead(laser_pin) == HIGH;
+  }
 
 private:
   uint8_t laser_pin;
+  bool timer_mode;
+
+  // Set (COM1A = 11) or clear (COM1A = 10) OC1A on the next compare match
+  inline void arm(bool enable) {
+    TCCR1A = (TCCR1A & ~(1 << COM1A0)) | (1 << COM1A1) | (enable << COM1A0);
+  }
+
+  inline void arm_disconnect() {
+    TCCR1A &= ~((1 << COM1A1) | (1 << COM1A0));
+  }
 };
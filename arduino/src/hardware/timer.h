@@ -2,6 +2,7 @@
 
 #include "../config.h"
 #include "../debug.h"
+#include "../diagnostics/trace.h"
 #include "../types.h"
 #include <Arduino.h>
 
@@ -32,6 +33,11 @@ public:
   void setCallback(timer_callback_t callback);
   void setDataSource(data_source_callback_t data_source);
   void setHardwareOutput(hardware_output_callback_t hardware_output);
+
+  // Hardware-timed laser (LASER_MODE_TIMER) - the period moves from OCR1A to
+  // ICR1 (CTC mode 12) so OCR1A can hold the laser edge offset, and the ISR
+  // runs on the ICR1 match at the start of each period
+  void setLaserTiming(bool hardware_laser, uint16_t edge_offset);
   timer_callback_t getCallback() const { return callback; }
   data_source_callback_t getDataSource() const { return data_source; }
   hardware_output_callback_t getHardwareOutput() const {
@@ -41,6 +47,8 @@ public:
 private:
   uint32_t frequency;
   bool enabled;
+  bool hardware_laser;
+  uint16_t edge_offset; // Timer ticks into the period
   timer_callback_t callback;
   data_source_callback_t data_source;
   hardware_output_callback_t hardware_output;
@@ -52,6 +60,8 @@ Timer *g_timer_instance = nullptr;
 Timer::Timer() {
   frequency = g_config.timer.frequency;
   enabled = g_config.timer.enabled;
+  hardware_laser = g_config.laser.mode == LASER_MODE_TIMER;
+  edge_offset = g_config.laser.edge_offset;
   callback = nullptr;
   data_source = nullptr;
   hardware_output = nullptr;
@@ -59,14 +69,20 @@ Timer::Timer() {
 }
 
 void Timer::init() {
+  uint8_t sreg = SREG;
   cli();
 
-  // Clear Timer/Counter Control Registers
-  TCCR1A = 0;
+  // Clear the Timer/Counter Control Registers - only the waveform bits of
+  // TCCR1A, the COM1A bits belong to the laser (see laser.h)
+  TCCR1A &= ~((1 << WGM11) | (1 << WGM10));
   TCCR1B = 0;
 
-  // Set CTC mode (Clear Timer on Compare Match)
+  // Set CTC mode (Clear Timer on Compare Match) - TOP is ICR1 when the
+  // laser is hardware timed, OCR1A otherwise
   TCCR1B |= (1 << WGM12);
+  if (hardware_laser) {
+    TCCR1B |= (1 << WGM13);
+  }
 
   // No prescaling for higher precision
   TCCR1B |= (1 << CS10);
@@ -75,7 +91,7 @@ void Timer::init() {
 
   enabled ? enable() : disable();
 
-  sei();
+  SREG = sreg;
 
   DEBUG_INFO(F("Timer initialized"));
 }
@@ -87,24 +103,50 @@ void Timer::setFrequency(uint32_t frequency) {
   }
 
   this->frequency = frequency;
-  OCR1A = (CLOCK_FREQ / frequency) - 1;
+  uint16_t top = (CLOCK_FREQ / frequency) - 1;
+  if (hardware_laser) {
+    ICR1 = top;
+    OCR1A = MIN(edge_offset, top);
+  } else {
+    OCR1A = top;
+  }
   DEBUG_INFO(F("Timer frequency set to %d"), frequency);
 }
 
 void Timer::enable() {
-  TIMSK1 |= (1 << OCIE1A);
+  TIMSK1 &= ~((1 << OCIE1A) | (1 << ICIE1));
+  TIMSK1 |= hardware_laser ? (1 << ICIE1) : (1 << OCIE1A);
   enabled = true;
   DEBUG_INFO(F("Timer enabled"));
 }
 
 void Timer::disable() {
-  TIMSK1 &= ~(1 << OCIE1A);
+  TIMSK1 &= ~((1 << OCIE1A) | (1 << ICIE1));
   enabled = false;
   DEBUG_INFO(F("Timer disabled"));
 }
 
 uint32_t Timer::getFrequency() const { return frequency; }
 
+void Timer::setLaserTiming(bool hardware_laser, uint16_t edge_offset) {
+  uint8_t sreg = SREG;
+  cli();
+
+  this->hardware_laser = hardware_laser;
+  this->edge_offset = edge_offset;
+
+  if (hardware_laser) {
+    TCCR1B |= (1 << WGM13);
+  } else {
+    TCCR1B &= ~(1 << WGM13);
+  }
+
+  setFrequency(frequency);
+  enabled ? enable() : disable();
+
+  SREG = sreg;
+}
+
 void Timer::setCallback(timer_callback_t callback) {
   this->callback = callback;
 }
@@ -117,7 +159,7 @@ void Timer::setHardwareOutput(hardware_output_callback_t hardware_output) {
   this->hardware_output = hardware_output;
 }
 
-ISR(TIMER1_COMPA_vect) {
+static inline void timer_isr() {
   DEBUG_ISR_PIN_ON();
 
   if (g_timer_instance && g_timer_instance->getDataSource() &&
@@ -130,8 +172,13 @@ ISR(TIMER1_COMPA_vect) {
       // Output the data using the hardware output callback
       g_timer_instance->getHardwareOutput()(&point, &laser_state);
     } else {
+      TRACE_EVENT(TRACE_EVT_STEP_UNDERRUN, 0, 0);
     }
   }
 
   DEBUG_ISR_PIN_OFF();
 }
+
+// Period match - OCR1A, or ICR1 when the laser is hardware timed
+ISR(TIMER1_COMPA_vect) { timer_isr(); }
+ISR(TIMER1_CAPT_vect) { timer_isr(); }
@@ -1,7 +1,12 @@
 #include "comm/command.h"
 #include "config.h"
+#include "diagnostics/memory.h"
+#include "diagnostics/profiler.h"
+#include "diagnostics/trace.h"
 #include "hardware/hardware.h"
+#include "renderer/grid.h"
 #include "renderer/renderer.h"
+#include "renderer/show.h"
 #include <Arduino.h>
 #include <EEPROM.h>
 #include <SPI.h>
@@ -15,9 +20,14 @@ void setup() {
   DEBUG_INFO(F("Hardware initialized"));
   renderer.init();
   DEBUG_INFO(F("Renderer initialized"));
+  show.init();
   Hardware::setDataSource((void *)renderer_data_source);
   DEBUG_INFO(F("Data source set"));
 
+  if (mem_free_ram() < MIN_FREE_MEMORY) {
+    DEBUG_ERROR(F("Free RAM below MIN_FREE_MEMORY"));
+  }
+
 #if ENABLE_DEBUG_PINS
   pinMode(DEBUG_DAC_PIN, OUTPUT);
   pinMode(DEBUG_ISR_PIN, OUTPUT);
@@ -28,11 +38,21 @@ void setup() {
 }
 
 void loop() {
+  PROFILE_ZONE(PROFILE_LOOP);
+
   DEBUG_DAC_PIN_ON();
-  DEBUG_INFO(F("Loop started"));
   renderer.process();
-  DEBUG_INFO(F("Loop completed"));
-
   DEBUG_DAC_PIN_OFF();
-  serialCommands.readSerial();
+  show.process();
+#if ENABLE_GRID
+  if (grid_poll()) {
+    renderer.update_grid();
+  }
+#endif
+
+  {
+    PROFILE_ZONE(PROFILE_SERIAL_READ);
+    serialCommands.readSerial();
+  }
+  TRACE_DRAIN(Serial);
 }
@@ -2,7 +2,13 @@
 
 #include "../config.h"
 #include "../debug.h"
+#include "../diagnostics/trace.h"
 #include "../types.h"
+#include "frame_format.h"
+#include "generator.h"
+#include "program.h"
+#include "sprite.h"
+#include "text.h"
 #include <Arduino.h>
 
 struct step_ring_buf_16_t {
@@ -14,11 +20,23 @@ struct step_ring_buf_16_t {
   volatile uint8_t head = 0;
   volatile uint8_t tail = 0;
 
+  // Laser delay line - the flag pushed with a step is written delay steps
+  // later (delay > 0) or earlier (delay < 0) in the ring, so laser edges can
+  // be lined up with the galvos without extra points. Only push() touches
+  // these, so they need no protection from the ISR.
+  int8_t laser_delay = 0;
+  uint16_t laser_history = 0; // Last flags pushed, newest in bit 0
+
   inline void clear() {
     memset(point_buf, 0, sizeof(point_buf));
     flag_buf = 0;
     head = 0;
     tail = 0;
+    laser_history = 0;
+  }
+
+  inline void set_laser_delay(int8_t delay) {
+    laser_delay = constrain(delay, -MAX_LASER_DELAY, MAX_LASER_DELAY);
   }
 
   // Buffer is empty when head == tail
@@ -66,14 +84,9 @@ struct step_ring_buf_16_t {
     tail = (tail + 1) & STEP_RING_BUFFER_MASK; // modulo STEP_RING_BUFFER_SIZE
     interrupts();                              // Critical section end
 
-    DEBUG_VERBOSE_VAL2("step_ring_buf_16_t::pop: Point ", point->x, point->y);
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::pop: Flag ", *flag);
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::pop: Head ", head);
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::pop: Tail ", tail);
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::pop: Size ", size());
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::pop: Space ", space());
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::pop: Is full ", is_full());
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::pop: Is empty ", is_empty());
+    // Called from the timer ISR - never print here, trace instead
+    TRACE_EVENT(TRACE_EVT_STEP_POP, *flag,
+                (head - tail) & STEP_RING_BUFFER_MASK);
 
     return true;
   }
@@ -85,28 +98,54 @@ struct step_ring_buf_16_t {
       return false;
     }
 
+    laser_history = (laser_history << 1) | flag;
+
     noInterrupts(); // Critical section start
     point_buf[head] = point;
 
-    // Clear and set
-    flag_buf &= ~(1 << head);
-    flag_buf |= (flag << head);
+    if (laser_delay > 0) {
+      // Lagging - this step gets the flag pushed delay steps ago
+      write_flag(head, (laser_history >> laser_delay) & 1);
+    } else {
+      write_flag(head, flag);
+
+      // Leading - move the edge back onto a step still waiting in the ring.
+      // If the ISR has already taken it the ring is starved and the edge
+      // just lands late.
+      uint8_t lead = -laser_delay;
+      if (lead > 0 && ((head - tail) & STEP_RING_BUFFER_MASK) >= lead) {
+        write_flag((head - lead) & STEP_RING_BUFFER_MASK, flag);
+      }
+    }
 
     head = (head + 1) & STEP_RING_BUFFER_MASK; // modulo STEP_RING_BUFFER_SIZE
     interrupts();                              // Critical section end
 
-    DEBUG_VERBOSE_VAL2("step_ring_buf_16_t::push: Point ", point.x, point.y);
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::push: Flag ", flag);
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::push: Head ", head);
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::push: Tail ", tail);
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::push: Size ", size());
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::push: Space ", space());
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::push: Is full ", is_full());
-    DEBUG_VERBOSE_VAL("step_ring_buf_16_t::push: Is empty ", is_empty());
+    TRACE_EVENT(TRACE_EVT_STEP_PUSH, flag,
+                (head - tail) & STEP_RING_BUFFER_MASK);
 
     return true;
   }
 
+  // Hold the beam dark at point - the last step is what the ISR keeps
+  // showing when the ring runs dry. The blanked flag is written straight to
+  // the step rather than through the delay line, and when the ring is full
+  // the newest step is blanked in its place, so the park always lands.
+  inline void park(point_q12_4_t point) {
+    noInterrupts(); // Critical section start
+    laser_history = 0;
+    if (((head + 1) & STEP_RING_BUFFER_MASK) == tail) {
+      write_flag((head - 1) & STEP_RING_BUFFER_MASK, false);
+    } else {
+      point_buf[head] = point;
+      write_flag(head, false);
+      head = (head + 1) & STEP_RING_BUFFER_MASK;
+    }
+    interrupts(); // Critical section end
+
+    TRACE_EVENT(TRACE_EVT_STEP_PUSH, 0, (head - tail) & STEP_RING_BUFFER_MASK);
+  }
+
   // Just in case
   inline bool peek(point_q12_4_t *point, bool *flag) const {
     noInterrupts(); // Critical section start
@@ -122,78 +161,523 @@ struct step_ring_buf_16_t {
     interrupts(); // Critical section end
     return true;
   }
+
+private:
+  // Clear and set - interrupts must be off
+  inline void write_flag(uint8_t index, bool flag) {
+    flag_buf &= ~(1 << index);
+    flag_buf |= (flag << index);
+  }
 };
 
-struct coord8_point_buf_t {
-  point_coord8_t points[MAX_POINTS];
+static_assert(sizeof(step_ring_buf_16_t) <= mem_budget::step_ring_bytes,
+              "step_ring_buf_16_t larger than its memory budget");
+
+// A frame stored in the point arena
+struct frame_region_t {
+  uint16_t offset; // First byte in the arena
+  uint16_t length; // Bytes used, including any segment table
   uint8_t point_count;
+  uint8_t format;          // frame_format_t
+  uint16_t table;          // Segment table position in the frame, 0 if none
+  uint8_t table_step_size; // max_step_size the table was computed with
+  uint8_t table_blank_step_size; // blank_step_size the table was computed with
+  bool table_stale;              // Transform changed since it was computed
 
   inline void clear() {
-    DEBUG_VERBOSE("coord8_point_buf_t::clear");
-    memset(points, 0, MAX_POINTS);
-
+    offset = 0;
+    length = 0;
     point_count = 0;
+    format = FRAME_FORMAT_ABSOLUTE;
+    table = 0;
+    table_step_size = 0;
+    table_blank_step_size = 0;
+    table_stale = false;
   }
 
-  void set_laser_state(uint8_t index, bool state) {
-    if (index >= MAX_POINTS) {
-      DEBUG_ERROR("coord8_point_buf_t::set_laser_state: Index out of range");
-      return;
+  inline bool is_empty() const { return point_count == 0; }
+  inline bool has_table() const { return table != 0; }
+
+  // Bytes of point data
+  inline uint16_t data_length() const { return table ? table : length; }
+};
+
+// Read position within a frame - delta and generated frames can only be read
+// in order
+struct frame_cursor_t {
+  uint16_t pos;         // Byte offset of the next record
+  uint8_t index;        // Index of the next point (wraps in a long frame)
+  point_coord8_t point; // Last point read (delta base)
+
+  // Generated frames - the member for the frame's format
+  union {
+    uint8_t element;             // Sprites: next point of the instance at pos
+#if ENABLE_PROGRAMS
+    program_state_t program;     // FRAME_FORMAT_PROGRAM
+#endif
+    text_state_t text;           // FRAME_FORMAT_TEXT
+    generator_state_t generator; // FRAME_FORMAT_GENERATOR
+  };
+
+  inline void reset() {
+    pos = 0;
+    index = 0;
+    point = point_coord8_t();
+    // All 0 is the reset state of every member, so the cursor needn't know
+    // the format
+    memset(&element, 0,
+           sizeof(frame_cursor_t) - offsetof(frame_cursor_t, element));
+  }
+};
+
+// Append position in a delta frame being written
+struct frame_tail_t {
+  uint8_t index;        // Index of the next point
+  point_coord8_t point; // Last point written (delta base)
+
+  inline void reset() {
+    index = 0;
+    point = point_coord8_t();
+  }
+};
+
+/*
+point_arena_t holds both the displayed (front) frame and the pending (back)
+frame in one block, each taking only the bytes it needs.
+
+The front frame always sits against one end of the arena, so the back frame
+always gets a single contiguous gap of POINT_ARENA_SIZE - front.length bytes:
+
+  front at start:  [ front | back -->              ]
+  front at end:    [ back -->              | front ]
+
+When the front frame is at the start, commit() moves the back frame up
+against the end of the arena. After swap() the new front frame is therefore
+at the opposite end from the old one, and the whole remaining gap is free
+for the next frame.
+
+Absolute frames reserve 3 bytes per point in begin() and can be written in
+any order. Delta frames (see frame_format.h) start empty and grow as points
+are appended, so they must be written in order and only fail once the gap
+is actually used up. Generated frames (programs, sprite lists, text and
+generators) grow a byte at a time the same way, and get their point count
+when they are finished.
+
+The ISR never reads the arena, only the renderer (loop context) and the
+serial commands do, so none of this needs interrupts disabled.
+*/
+struct point_arena_t {
+  uint8_t bytes[POINT_ARENA_SIZE];
+  frame_region_t front;
+  frame_region_t back;
+  bool back_ready;     // Back frame committed, waiting to be swapped in
+  frame_tail_t tail;   // Delta frames: append position in the back frame
+
+  inline void clear() {
+    DEBUG_VERBOSE("point_arena_t::clear");
+    front.clear();
+    back.clear();
+    back_ready = false;
+    tail.reset();
+  }
+
+  inline uint16_t free_bytes() const { return POINT_ARENA_SIZE - front.length; }
+
+  // Points that fit next to the front frame in the absolute format
+  inline uint8_t free_points() const {
+    uint16_t points = free_bytes() / sizeof(point_coord8_t);
+    return points > MAX_FRAME_POINTS ? MAX_FRAME_POINTS : points;
+  }
+
+  // Start a new back frame, discarding any uncommitted or unswapped one.
+  // point_count is ignored for generated frames.
+  // Returns false if the frame cannot fit next to the front frame
+  bool begin(uint8_t point_count, uint8_t format = FRAME_FORMAT_ABSOLUTE) {
+    bool generated = FRAME_FORMAT_IS_GENERATED(format);
+
+    // Delta records are at least one byte per point
+    uint16_t length = format == FRAME_FORMAT_DELTA ? point_count
+                      : generated ? 0
+                                  : point_count * sizeof(point_coord8_t);
+
+    if ((!generated && point_count < MIN_POINTS) || length > free_bytes()) {
+      DEBUG_INFO("point_arena_t::begin: Frame does not fit");
+      return false;
+    }
+
+    back.offset = front.offset == 0 ? front.length : 0;
+    back.point_count = generated ? 0 : point_count;
+    back.format = format;
+    back.table = 0;
+    back_ready = false;
+    tail.reset();
+
+    if (format == FRAME_FORMAT_ABSOLUTE) {
+      back.length = length;
+      memset(bytes + back.offset, 0, length);
+    } else {
+      back.length = 0;
     }
-    this->points[index].flags = state ? BLANKING_BIT : 0;
+    return true;
   }
 
-  bool get_laser_state(uint8_t index) {
-    if (index >= MAX_POINTS) {
-      DEBUG_ERROR("coord8_point_buf_t::get_laser_state: Index out of range");
+  // Returns false if the index is out of range, or for delta frames if the
+  // point is out of order or there is no room left for it - the delta frame
+  // then starts over from point 0
+  bool set_point(uint8_t index, point_coord8_t point) {
+    if (index >= back.point_count) {
+      DEBUG_ERROR("point_arena_t::set_point: Index out of range");
+      return false;
+    }
+
+    if (back.format == FRAME_FORMAT_ABSOLUTE) {
+      memcpy(bytes + back.offset + index * sizeof(point_coord8_t), &point,
+             sizeof(point_coord8_t));
+      return true;
+    }
+
+    if (index != tail.index) {
+      DEBUG_ERROR("point_arena_t::set_point: Delta points out of order");
+      restart_delta();
+      return false;
+    }
+
+    uint8_t record[FRAME_RECORD_MAX_SIZE];
+    uint8_t size = frame_encode_point(tail.point, point, record);
+
+    if (back.length + size > free_bytes()) {
+      DEBUG_INFO("point_arena_t::set_point: Arena full");
+      restart_delta();
       return false;
     }
-    return this->points[index].flags & BLANKING_BIT;
+
+    memcpy(bytes + back.offset + back.length, record, size);
+    back.length += size;
+    tail.index++;
+    tail.point = point;
+    return true;
   }
 
-  void set_coords(uint8_t index, uint8_t x, uint8_t y) {
-    if (index >= MAX_POINTS) {
-      DEBUG_ERROR("coord8_point_buf_t::set_coords: Index out of range");
-      return;
+  // A failed delta append drops the points written so far, as begin() does,
+  // so the next one starts again at point 0 rather than from a stale index
+  // and base point
+  inline void restart_delta() {
+    back.length = 0;
+    tail.reset();
+  }
+
+  // Append a byte to a generated back frame
+  // Returns false if the back frame is not generated or there is no room
+  bool append_byte(uint8_t byte) {
+    if (!FRAME_FORMAT_IS_GENERATED(back.format) ||
+        back.length >= free_bytes()) {
+      DEBUG_INFO("point_arena_t::append_byte: Arena full");
+      return false;
     }
-    this->points[index].x = x;
-    this->points[index].y = y;
+    bytes[back.offset + back.length++] = byte;
+    return true;
   }
 
-  void get_coords(uint8_t index, uint8_t *x, uint8_t *y) {
-    if (index >= MAX_POINTS) {
-      DEBUG_ERROR("coord8_point_buf_t::get_coords: Index out of range");
-      return;
+  // Check a generated back frame and set its point count to one pass
+  // (capped at 255). Returns false if it is faulty or outputs no points.
+  bool finish_generated() {
+    const uint8_t *data = bytes + back.offset;
+    uint16_t points = 0;
+    bool ok;
+
+    if (back.format == FRAME_FORMAT_SPRITES) {
+      ok = sprite_count_points(data, back.length, &points);
+    } else if (back.format == FRAME_FORMAT_TEXT) {
+      ok = text_count_points(data, back.length, &points);
+#if ENABLE_PROGRAMS
+    } else if (back.format == FRAME_FORMAT_PROGRAM) {
+      program_state_t state;
+      state.reset();
+
+      point_coord8_t point;
+      program_result_t result;
+      while ((result = program_next_point(data, back.length, &state,
+                                          &point)) == PROGRAM_POINT) {
+      }
+      points = state.points;
+      ok = result != PROGRAM_FAULT;
+#endif
+    } else {
+      ok = generator_count_points(data, back.length, &points);
+    }
+
+    if (!ok || points == 0) {
+      DEBUG_ERROR("point_arena_t::finish_generated: Bad frame");
+      return false;
     }
-    *x = this->points[index].x;
-    *y = this->points[index].y;
+    back.point_count = points > 255 ? 255 : points;
+    return true;
   }
 
-  void set_point(uint8_t index, point_coord8_t point) {
-    if (index >= MAX_POINTS) {
-      DEBUG_ERROR("coord8_point_buf_t::set_point: Index out of range");
-      return;
+  // Read the point at cursor->index and advance the cursor
+  // Returns false at the end of the frame or on a corrupt record
+  bool next_point(const frame_region_t &frame, frame_cursor_t *cursor,
+                  point_coord8_t *point) const {
+#if ENABLE_PROGRAMS
+    if (frame.format == FRAME_FORMAT_PROGRAM) {
+      if (program_next_point(bytes + frame.offset, frame.data_length(),
+                             &cursor->program, point) != PROGRAM_POINT) {
+        return false;
+      }
+      cursor->index++;
+      return true;
     }
-    this->points[index] = point;
+#endif
+
+    if (frame.format == FRAME_FORMAT_SPRITES) {
+      if (!sprite_next_point(bytes + frame.offset, frame.data_length(),
+                             &cursor->pos, &cursor->element, point)) {
+        return false;
+      }
+      cursor->index++;
+      return true;
+    }
+
+    if (frame.format == FRAME_FORMAT_TEXT) {
+      if (!text_next_point(bytes + frame.offset, frame.data_length(),
+                           &cursor->pos, &cursor->text, point)) {
+        return false;
+      }
+      cursor->index++;
+      return true;
+    }
+
+    if (frame.format == FRAME_FORMAT_GENERATOR) {
+      if (!generator_next_point(bytes + frame.offset, frame.data_length(),
+                                &cursor->pos, &cursor->generator, point)) {
+        return false;
+      }
+      cursor->index++;
+      return true;
+    }
+
+    if (cursor->index >= frame.point_count) {
+      return false;
+    }
+
+    if (frame.format == FRAME_FORMAT_ABSOLUTE) {
+      memcpy(point, bytes + frame.offset + cursor->pos,
+             sizeof(point_coord8_t));
+      cursor->pos += sizeof(point_coord8_t);
+    } else {
+      uint8_t size = frame_decode_point(bytes + frame.offset + cursor->pos,
+                                        frame.data_length() - cursor->pos,
+                                        &cursor->point);
+      if (size == 0) {
+        DEBUG_ERROR("point_arena_t::next_point: Bad delta record");
+        return false;
+      }
+      cursor->pos += size;
+      *point = cursor->point;
+    }
+
+    cursor->index++;
+    return true;
+  }
+
+  // True once the back frame has all its points and can be committed
+  bool back_complete() const {
+    if (back_ready) {
+      return false;
+    }
+    if (FRAME_FORMAT_IS_GENERATED(back.format)) {
+      return back.length > 0;
+    }
+    if (back.is_empty()) {
+      return false;
+    }
+    return back.format == FRAME_FORMAT_ABSOLUTE ||
+           tail.index == back.point_count;
+  }
+
+  /*
+  Segment tables - segment i (i >= 1) is the move from point i - 1 to point i,
+  stored as entry i - 1 after the back frame's points. Segment 0 comes from
+  whatever was drawn before, so it is never stored.
+
+  A table is only kept if a frame of the same size still fits next to it, so
+  precomputing never costs the double buffering. Generated frames have no
+  table - their points are not stored anywhere to index it by.
+  */
+  inline uint16_t table_bytes(const frame_region_t &frame) const {
+    return (frame.point_count - 1) * sizeof(segment_t);
+  }
+
+  bool reserve_table(uint8_t step_size, uint8_t blank_step_size) {
+    uint16_t size = table_bytes(back);
+    uint16_t data = back.data_length();
+
+    if (FRAME_FORMAT_IS_GENERATED(back.format) || size == 0 ||
+        back.length + size > free_bytes() ||
+        data * 2 + size > POINT_ARENA_SIZE) {
+      return false;
+    }
+
+    back.table = back.length;
+    back.table_step_size = step_size;
+    back.table_blank_step_size = blank_step_size;
+    back.table_stale = false;
+    back.length += size;
+    return true;
+  }
+
+  void set_segment(uint8_t index, const segment_t &segment) {
+    memcpy(bytes + back.offset + back.table + (index - 1) * sizeof(segment_t),
+           &segment, sizeof(segment_t));
+  }
+
+  void get_segment(const frame_region_t &frame, uint8_t index,
+                   segment_t *segment) const {
+    memcpy(segment,
+           bytes + frame.offset + frame.table + (index - 1) * sizeof(segment_t),
+           sizeof(segment_t));
+  }
+
+  // Fix the back frame's position so it is ready to swap in
+  bool commit() {
+    if (!back_complete()) {
+      DEBUG_INFO("point_arena_t::commit: Nothing to commit");
+      return false;
+    }
+
+    // Pack against the end, away from a front frame at the start
+    uint16_t packed = POINT_ARENA_SIZE - back.length;
+    if (front.offset == 0 && back.offset != packed) {
+      memmove(bytes + packed, bytes + back.offset, back.length);
+      back.offset = packed;
+    }
+
+    back_ready = true;
+    return true;
+  }
+
+  // Make the committed back frame the front frame, freeing the old front
+  bool swap() {
+    if (!back_ready) {
+      return false;
+    }
+
+    front = back;
+    back.clear();
+    back_ready = false;
+    return true;
+  }
+};
+
+static_assert(sizeof(point_arena_t) <=
+                  mem_budget::point_arena_bytes(MAX_POINTS),
+              "point_arena_t larger than its memory budget");
+
+enum step_cache_state_t : uint8_t {
+  STEP_CACHE_EMPTY,     // Nothing recorded
+  STEP_CACHE_RECORDING, // Recording the current pass
+  STEP_CACHE_VALID,     // A whole pass is recorded
+  STEP_CACHE_FULL,      // The pass did not fit - retry only if config changes
+};
+
+#if ENABLE_STEP_CACHE
+/*
+step_cache_t records the output steps of one pass of a repeating frame and
+replays them on later passes, skipping interpolation altogether. A pass of
+more than STEP_CACHE_STEPS steps is never cached.
+
+Each step is 4 bytes: x with the laser state in bit 15, then y. Q12.4
+coordinates are never negative, so bit 15 is free.
+*/
+struct step_cache_t {
+  uint16_t count; // Steps recorded
+  uint16_t index; // Next step to replay
+  uint8_t state;  // step_cache_state_t
+
+  // Renderer config the pass was recorded with
+  config_t::renderer_config_t config;
+
+  uint16_t steps[STEP_CACHE_STEPS][2];
+
+  inline void invalidate() {
+    state = STEP_CACHE_EMPTY;
+    count = 0;
+    index = 0;
   }
 
-  void get_point(uint8_t index, point_coord8_t *point) {
-    if (index >= MAX_POINTS) {
-      DEBUG_ERROR("coord8_point_buf_t::get_point: Index out of range");
+  inline bool is_valid() const { return state == STEP_CACHE_VALID; }
+
+  inline bool config_matches() const {
+    return memcmp(&config, &g_config.renderer, sizeof(config)) == 0;
+  }
+
+  // Not worth recording again until the config changes
+  inline bool is_full() const {
+    return state == STEP_CACHE_FULL && config_matches();
+  }
+
+  inline void start_recording() {
+    state = STEP_CACHE_RECORDING;
+    count = 0;
+    index = 0;
+    config = g_config.renderer;
+  }
+
+  // Append a step - gives up on this frame once the cache is full
+  inline void record(point_q12_4_t point, bool laser) {
+    if (state != STEP_CACHE_RECORDING) {
       return;
     }
-    *point = this->points[index];
+
+    if (count == STEP_CACHE_STEPS) {
+      state = STEP_CACHE_FULL;
+      return;
+    }
+
+    steps[count][0] = (uint16_t)point.x | (laser ? 0x8000 : 0);
+    steps[count][1] = point.y;
+    count++;
   }
 
-  void set_point_count(uint8_t count) {
-    if (count > MAX_POINTS) {
-      DEBUG_ERROR("coord8_point_buf_t::set_point_count: Count out of range");
+  // End of a pass - the recording is only usable if nothing changed under it
+  inline void finish_recording() {
+    if (state != STEP_CACHE_RECORDING) {
       return;
     }
-    this->point_count = count;
+    state = count && config_matches() ? STEP_CACHE_VALID : STEP_CACHE_EMPTY;
   }
 
-  uint8_t get_point_count() const { return this->point_count; }
+  inline void rewind() { index = 0; }
+  inline bool replay_done() const { return index >= count; }
+
+  // The pass just finished came from the cache
+  inline bool replayed() const { return is_valid() && index != 0; }
+
+  inline void replay(point_q12_4_t *point, bool *laser) {
+    point->x = steps[index][0] & 0x7FFF;
+    point->y = steps[index][1];
+    *laser = steps[index][0] & 0x8000;
+    index++;
+  }
+};
 
-  inline bool is_empty() const { return this->point_count == 0; }
+static_assert(sizeof(step_cache_t) <= mem_budget::step_cache_bytes,
+              "step_cache_t larger than its memory budget");
+#else
+// Compiled out - never holds a pass, so the renderer always draws live
+struct step_cache_t {
+  static constexpr uint16_t count = 0;
+
+  inline void invalidate() {}
+  inline bool is_valid() const { return false; }
+  inline bool config_matches() const { return false; }
+  inline bool is_full() const { return true; }
+  inline void start_recording() {}
+  inline void record(point_q12_4_t point, bool laser) {}
+  inline void finish_recording() {}
+  inline void rewind() {}
+  inline bool replay_done() const { return true; }
+  inline bool replayed() const { return false; }
+  inline void replay(point_q12_4_t *point, bool *laser) {}
 };
+#endif
@@ -0,0 +1,111 @@
+#include "cordic.h"
+#include <avr/pgmspace.h>
+
+// atan(2^-i) in CORDIC_TURN units
+static const int32_t atan_table[CORDIC_ITERATIONS] PROGMEM = {
+    134217728, 79233351, 41864727, 21251189, 10666833, 5338616,
+    2669960,   1335061,  667541,   333772,   166886,   83443,
+    41722,     20861,    10430,    5215,     2608,     1304,
+    652,       326,      163,      81,       41,       20};
+
+// 1 / gain of CORDIC_ITERATIONS rotations in Q1.30
+#define CORDIC_GAIN_INV 652032874L
+
+// Vectors are scaled up to this before atan2 - more bits of angle, and room
+// for the 1.65x gain
+#define CORDIC_ATAN2_RANGE (1L << 28)
+
+// hypot's inputs are scaled up by this many bits
+#define CORDIC_HYPOT_SHIFT 16
+
+// Rotates (x, y) onto the positive x axis. Returns the angle it started at,
+// leaves x at the length times the CORDIC gain. |x|, |y| must be under
+// CORDIC_ATAN2_RANGE.
+static int32_t cordic_vector(int32_t *x, int32_t *y) {
+  int32_t angle = 0;
+  if (*x < 0) {
+    *x = -*x;
+    *y = -*y;
+    angle = CORDIC_HALF_TURN;
+  }
+
+  for (uint8_t i = 0; i < CORDIC_ITERATIONS; i++) {
+    int32_t dx = *x >> i;
+    int32_t dy = *y >> i;
+    int32_t step = pgm_read_dword(&atan_table[i]);
+    if (*y > 0) {
+      *x += dy;
+      *y -= dx;
+      angle += step;
+    } else {
+      *x -= dy;
+      *y += dx;
+      angle -= step;
+    }
+  }
+
+  if (angle > CORDIC_HALF_TURN) {
+    angle -= CORDIC_TURN;
+  }
+  return angle;
+}
+
+int32_t cordic_atan2(int32_t y, int32_t x) {
+  if (x == 0 && y == 0) {
+    return 0;
+  }
+
+  while (ABS(x) >= CORDIC_ATAN2_RANGE || ABS(y) >= CORDIC_ATAN2_RANGE) {
+    x >>= 1;
+    y >>= 1;
+  }
+  while (ABS(x) < CORDIC_ATAN2_RANGE / 2 && ABS(y) < CORDIC_ATAN2_RANGE / 2) {
+    x <<= 1;
+    y <<= 1;
+  }
+  return cordic_vector(&x, &y);
+}
+
+uint16_t cordic_hypot(int16_t x, int16_t y) {
+  int32_t vx = (int32_t)x << CORDIC_HYPOT_SHIFT;
+  int32_t vy = (int32_t)y << CORDIC_HYPOT_SHIFT;
+  cordic_vector(&vx, &vy);
+
+  int32_t length = ((int64_t)vx * CORDIC_GAIN_INV) >> CORDIC_SHIFT;
+  return (length + (1L << (CORDIC_HYPOT_SHIFT - 1))) >> CORDIC_HYPOT_SHIFT;
+}
+
+void cordic_sincos(int32_t angle, int32_t *cosine, int32_t *sine) {
+  // Into -half..half a turn, then within a quarter turn of 0 - the most
+  // CORDIC converges for - with the result turned half a turn back
+  angle = (int32_t)(((uint32_t)angle + CORDIC_HALF_TURN) & (CORDIC_TURN - 1)) -
+          CORDIC_HALF_TURN;
+  bool negate = false;
+  if (angle > CORDIC_QUARTER_TURN) {
+    angle -= CORDIC_HALF_TURN;
+    negate = true;
+  } else if (angle < -CORDIC_QUARTER_TURN) {
+    angle += CORDIC_HALF_TURN;
+    negate = true;
+  }
+
+  int32_t x = CORDIC_GAIN_INV;
+  int32_t y = 0;
+  for (uint8_t i = 0; i < CORDIC_ITERATIONS; i++) {
+    int32_t dx = x >> i;
+    int32_t dy = y >> i;
+    int32_t step = pgm_read_dword(&atan_table[i]);
+    if (angle > 0) {
+      x -= dy;
+      y += dx;
+      angle -= step;
+    } else {
+      x += dy;
+      y -= dx;
+      angle += step;
+    }
+  }
+
+  *cosine = negate ? -x : x;
+  *sine = negate ? -y : y;
+}
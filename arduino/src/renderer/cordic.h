@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * CORDIC
+ * ============================================================================
+ *
+ * Integer sine/cosine, atan2 and vector length by shift-and-add rotations.
+ * Used when a move is set up - never per step.
+ *
+ * Angles are binary, CORDIC_TURN per full turn, counterclockwise. Sine and
+ * cosine come out in Q1.30 (CORDIC_ONE = 1.0). CORDIC_ITERATIONS rotations
+ * leave an error of a few units of CORDIC_TURN.
+ *
+ * ============================================================================
+ */
+
+#define CORDIC_TURN (1L << 30)
+#define CORDIC_HALF_TURN (CORDIC_TURN >> 1)
+#define CORDIC_QUARTER_TURN (CORDIC_TURN >> 2)
+#define CORDIC_SHIFT 30
+#define CORDIC_ONE (1L << CORDIC_SHIFT)
+#define CORDIC_ITERATIONS 24
+
+// Angle of (x, y), -CORDIC_HALF_TURN..CORDIC_HALF_TURN. 0 for (0, 0).
+int32_t cordic_atan2(int32_t y, int32_t x);
+
+// Length of (x, y), rounded
+uint16_t cordic_hypot(int16_t x, int16_t y);
+
+// Cosine and sine of any angle in Q1.30
+void cordic_sincos(int32_t angle, int32_t *cosine, int32_t *sine);
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "../config.h"
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * CURVE SEGMENTS
+ * ============================================================================
+ *
+ * A frame point with CURVE_CONTROL_BIT set is not drawn - it is a Bezier
+ * control point of the segment into the next drawn point:
+ *
+ *   P0 (last drawn point), C, P1              quadratic
+ *   P0 (last drawn point), C1, C2, P1         cubic
+ *
+ * Further control points before the same end point are ignored. Control
+ * points at the end of the frame belong to the segment back to the first
+ * point, so closed outlines can be curved all the way round. Control points
+ * go through the transform like any other point.
+ *
+ * The interpolator draws a curve with forward differencing in fixed point -
+ * three additions per axis per step. The step count is a power of two picked
+ * from the control polygon's length and the lit step size, so the
+ * differences are exact integers and the curve lands on P1 without drift.
+ * At most 1 << CURVE_MAX_SHIFT points are worked out that way - the 32 bit
+ * differences have no room for more - and a longer curve is subdivided with
+ * straight steps between them. The chords stay within a fraction of a coord8
+ * unit of the curve.
+ *
+ * A frame point with ARC_CENTRE_BIT set is the centre of a circular arc
+ * instead - the segment into the next drawn point P1 is an arc around it,
+ * starting at the last drawn point P0:
+ *
+ *   radius        |P0 - centre|
+ *   start angle   direction of P0 from the centre
+ *   sweep         round to the direction of P1, counterclockwise or with
+ *                 ARC_CLOCKWISE_BIT clockwise; P1 == P0 is a full circle
+ *
+ * The arc is drawn by rotating the radius vector a fixed angle at a time.
+ * The rotation's sine and cosine are worked out once with CORDIC (cordic.h)
+ * and rounded to Q1.15, so a step takes only 16 x 16 bit multiplies. The
+ * step count comes from the arc length and the lit step size. Past
+ * ARC_MAX_POINTS the arc is subdivided like a long curve, with straight
+ * steps between the points worked out. An arc centre replaces any control
+ * points before it and later ones are ignored. A mirroring transform (one
+ * flip, or swap_xy) reverses the direction, so the arc stays on the same
+ * side.
+ *
+ * Curves are always lit. A blanked segment is travelled in a straight line,
+ * whatever its control points.
+ *
+ * ============================================================================
+ */
+
+#define CURVE_MAX_CONTROLS 2
+#define CURVE_MAX_SHIFT 6     // At most 64 points worked out per curve
+#define CURVE_MAX_SUB_SHIFT 4 // Each split into up to 16 straight steps
+#define ARC_MAX_POINTS 64     // At most 64 points worked out per arc
+#define ARC_MAX_SUB_SHIFT 5   // Each split into up to 32 straight steps
+#define ARC_MAX_OUTPUT 0x0FFF // DAC full scale
+
+// How a move is drawn
+enum move_shape_t : uint8_t {
+  MOVE_LINE,
+  MOVE_CURVE,
+  MOVE_CURVE_CLIPPED, // Crosses the safety zone edge - blanked outside it
+};
+
+enum curve_kind_t : uint8_t {
+  CURVE_BEZIER,
+  CURVE_ARC_CCW,
+  CURVE_ARC_CW,
+};
+
+struct curve_t {
+  point_q12_4_t control[CURVE_MAX_CONTROLS]; // Arcs: control[0] is the centre
+  uint8_t count; // 0 = straight, 1 = quadratic or arc, 2 = cubic
+  curve_kind_t kind;
+
+  inline void clear() {
+    count = 0;
+    kind = CURVE_BEZIER;
+  }
+
+  inline bool is_arc() const { return kind != CURVE_BEZIER; }
+
+  // Add a control point or arc centre read from the frame. mirrored is set
+  // if the transform reverses the arc direction.
+  inline void add(point_q12_4_t point, uint8_t flags, bool mirrored) {
+    if (flags & ARC_CENTRE_BIT) {
+      control[0] = point;
+      count = 1;
+      bool clockwise = (flags & ARC_CLOCKWISE_BIT) ? !mirrored : mirrored;
+      kind = clockwise ? CURVE_ARC_CW : CURVE_ARC_CCW;
+    } else if (!is_arc() && count < CURVE_MAX_CONTROLS) {
+      control[count++] = point;
+    }
+  }
+
+  // Direction the move leaves start and arrives at end in - the tangents for
+  // a curve, the chord for a straight move
+  inline point_q12_4_t entry(point_q12_4_t start, point_q12_4_t end) const {
+    if (is_arc()) {
+      return tangent(start);
+    }
+    return (count ? control[0] : end) - start;
+  }
+  inline point_q12_4_t exit(point_q12_4_t start, point_q12_4_t end) const {
+    if (is_arc()) {
+      return tangent(end);
+    }
+    return end - (count ? control[count - 1] : start);
+  }
+
+  // Arc tangent at point - the radius turned a quarter turn
+  inline point_q12_4_t tangent(point_q12_4_t point) const {
+    point_q12_4_t radius = point - control[0];
+    return kind == CURVE_ARC_CCW ? point_q12_4_t(-radius.y, radius.x)
+                                 : point_q12_4_t(radius.y, -radius.x);
+  }
+};
@@ -0,0 +1,76 @@
+#include "dwell.h"
+#include <avr/pgmspace.h>
+
+// atan(i / 32) in binary angle units (45 degrees = 32)
+static const uint8_t atan_table[33] PROGMEM = {
+    0,  1,  3,  4,  5,  6,  8,  9,  10, 11, 12, 13, 15, 16, 17, 18, 19,
+    20, 21, 22, 23, 24, 25, 25, 26, 27, 28, 29, 29, 30, 31, 31, 32};
+
+uint8_t dwell_direction(point_q12_4_t delta) {
+  uint16_t ax = ABS(delta.x);
+  uint16_t ay = ABS(delta.y);
+
+  if (ax == 0 && ay == 0) {
+    return 0;
+  }
+
+  // First octant from the ratio of the shorter axis to the longer, rounded
+  // to the nearest table entry
+  uint8_t angle;
+  if (ax >= ay) {
+    angle = pgm_read_byte(&atan_table[(((uint32_t)ay << 5) + ax / 2) / ax]);
+  } else {
+    angle = 64 -
+            pgm_read_byte(&atan_table[(((uint32_t)ax << 5) + ay / 2) / ay]);
+  }
+
+  // Then mirror into the right quadrant
+  if (delta.x < 0) {
+    angle = 128 - angle;
+  }
+  if (delta.y < 0) {
+    angle = -angle;
+  }
+  return angle;
+}
+
+uint8_t dwell_curve(const uint8_t *curve, uint8_t x, uint8_t shift) {
+  uint8_t i = x >> shift;
+  if (i >= DWELL_CURVE_POINTS - 1) {
+    return curve[DWELL_CURVE_POINTS - 1];
+  }
+
+  uint8_t frac = x & ((1 << shift) - 1);
+  int16_t rise = (int16_t)curve[i + 1] - curve[i];
+  return curve[i] + ((rise * frac) >> shift);
+}
+
+uint8_t transition_dwell(const dwell_move_t &in, point_q12_4_t out,
+                         bool start_laser, bool end_laser) {
+  const config_t::renderer_config_t &config = g_config.renderer;
+
+  if (start_laser && end_laser) {
+    // Lit corner - turn 0..128 (180 degrees), curve points 16 apart
+    int8_t turn = dwell_direction(out) - dwell_direction(in.delta);
+    return dwell_curve(config.corner_dwell, ABS(turn), 4);
+  }
+
+  if (start_laser) {
+    return end_laser ? 0 : config.laser_off_dwell;
+  }
+
+  if (!end_laser) {
+    return 0;
+  }
+
+  // Landing from a jump - the jump curve alone, so a short jump settles
+  // for less than a full field one. Length in coord8 units, curve points
+  // 32 apart
+  if (in.blank) {
+    uint16_t length = MAX(ABS(in.delta.x), ABS(in.delta.y)) >> 4;
+    return dwell_curve(config.jump_dwell, MIN(length, 255), 5);
+  }
+
+  // Laser coming on with no jump before it
+  return config.laser_on_dwell;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../config.h"
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * ADAPTIVE DWELL
+ * ============================================================================
+ *
+ * Dwell steps are held at a point before the move away from it. On top of the
+ * fixed laser on/off edge dwell, two tunable curves in g_config.renderer add
+ * dwell where the galvos need it:
+ *
+ *   corner_dwell - lit corners, by turn angle 0..180 degrees
+ *   jump_dwell   - the end of a blanked jump, before the laser comes back on,
+ *                  by jump length 0..256 (coord8 units, longest axis)
+ *
+ * Each curve has DWELL_CURVE_POINTS evenly spaced entries and is linear in
+ * between. A landing from a jump uses jump_dwell alone, so short jumps settle
+ * for less than long ones - laser_on_dwell only covers a laser on edge with
+ * no jump before it.
+ *
+ * Angles are binary - 256 per turn - worked out from an arctangent table, so
+ * there is no floating point or trig on the render path.
+ *
+ * ============================================================================
+ */
+
+// The last move that went somewhere. Zero length moves (repeated points) are
+// skipped, so they don't hide the corner they sit on.
+struct dwell_move_t {
+  point_q12_4_t delta;
+  bool blank; // Laser off at both ends
+
+  inline void clear() {
+    delta = point_q12_4_t(0, 0);
+    blank = false;
+  }
+
+  inline void update(point_q12_4_t move, bool move_blank) {
+    if (move.x != 0 || move.y != 0) {
+      delta = move;
+      blank = move_blank;
+    }
+  }
+};
+
+// Direction of a move as a binary angle, 0 = +x, 64 = +y
+uint8_t dwell_direction(point_q12_4_t delta);
+
+// Curve value at x, where the curve points are 1 << shift apart
+uint8_t dwell_curve(const uint8_t *curve, uint8_t x, uint8_t shift);
+
+// Dwell steps before the move out, given the move that arrived at its start
+uint8_t transition_dwell(const dwell_move_t &in, point_q12_4_t out,
+                         bool start_laser, bool end_laser);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../config.h"
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * PRE-EMPHASIS
+ * ============================================================================
+ *
+ * Galvos lag the commanded position, so corners round off unless the step
+ * size is small or the dwell long. The filter adds a share of each step's
+ * movement on top of the step, per axis:
+ *
+ *   out = in + (gain * (in - previous in)) >> EMPHASIS_GAIN_SHIFT
+ *
+ * so the scanner is pushed a little past where it is heading and arrives on
+ * time. Dwell steps don't move and pass through unchanged, which lets the
+ * overshoot settle back at corners. gain = 0 turns an axis off.
+ *
+ * ============================================================================
+ */
+
+#define EMPHASIS_GAIN_SHIFT 4      // Gain is in 1/16ths
+#define EMPHASIS_MAX_OUTPUT 0x0FFF // DAC full scale
+
+struct emphasis_filter_t {
+  point_q12_4_t previous; // Last input step
+  uint8_t gain_x;
+  uint8_t gain_y;
+
+  inline void clear() { previous = point_q12_4_t(0, 0); }
+
+  inline void configure(uint8_t x, uint8_t y) {
+    gain_x = x;
+    gain_y = y;
+  }
+
+  inline bool is_enabled() const { return gain_x != 0 || gain_y != 0; }
+
+  // Filtered step - the history is kept while disabled, so turning the filter
+  // on doesn't kick the scanner
+  inline point_q12_4_t apply(point_q12_4_t point) {
+    if (!is_enabled()) {
+      previous = point;
+      return point;
+    }
+
+    point_q12_4_t out(emphasise(point.x, previous.x, gain_x),
+                      emphasise(point.y, previous.y, gain_y));
+    previous = point;
+    return out;
+  }
+
+private:
+  static inline int16_t emphasise(int16_t in, int16_t previous, uint8_t gain) {
+    int32_t out =
+        in + (((int32_t)(in - previous) * gain) >> EMPHASIS_GAIN_SHIFT);
+    return constrain(out, 0, EMPHASIS_MAX_OUTPUT);
+  }
+};
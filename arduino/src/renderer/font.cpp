@@ -0,0 +1,325 @@
+#include "font.h"
+#include <avr/pgmspace.h>
+
+#define M FONT_MOVE
+
+// Hershey Simplex vertices, glyph after glyph
+static const font_vertex_t font_vertices[] PROGMEM = {
+    // '!'
+    {M | 5, 21}, {5, 7}, {M | 5, 2}, {4, 1}, {5, 0}, {6, 1}, {5, 2},
+    // '"'
+    {M | 4, 21}, {4, 14}, {M | 12, 21}, {12, 14},
+    // '#'
+    {M | 11, 25}, {4, -7}, {M | 17, 25}, {10, -7}, {M | 4, 12}, {18, 12},
+    {M | 3, 6}, {17, 6},
+    // '$'
+    {M | 8, 25}, {8, -4}, {M | 12, 25}, {12, -4}, {M | 17, 18}, {15, 20},
+    {12, 21}, {8, 21}, {5, 20}, {3, 18}, {3, 16}, {4, 14}, {5, 13}, {7, 12},
+    {13, 10}, {15, 9}, {16, 8}, {17, 6}, {17, 3}, {15, 1}, {12, 0}, {8, 0},
+    {5, 1}, {3, 3},
+    // '%'
+    {M | 21, 21}, {3, 0}, {M | 8, 21}, {10, 19}, {10, 17}, {9, 15}, {7, 14},
+    {5, 14}, {3, 16}, {3, 18}, {4, 20}, {6, 21}, {8, 21}, {10, 20}, {13, 19},
+    {16, 19}, {19, 20}, {21, 21}, {M | 17, 7}, {15, 6}, {14, 4}, {14, 2},
+    {16, 0}, {18, 0}, {20, 1}, {21, 3}, {21, 5}, {19, 7}, {17, 7},
+    // '&'
+    {M | 23, 12}, {23, 13}, {22, 14}, {21, 14}, {20, 13}, {19, 11}, {17, 6},
+    {15, 3}, {13, 1}, {11, 0}, {7, 0}, {5, 1}, {4, 2}, {3, 4}, {3, 6}, {4, 8},
+    {5, 9}, {12, 13}, {13, 14}, {14, 16}, {14, 18}, {13, 20}, {11, 21}, {9, 20},
+    {8, 18}, {8, 16}, {9, 13}, {11, 10}, {16, 3}, {18, 1}, {20, 0}, {22, 0},
+    {23, 1}, {23, 2},
+    // '\''
+    {M | 5, 19}, {4, 20}, {5, 21}, {6, 20}, {6, 18}, {5, 16}, {4, 15},
+    // '('
+    {M | 11, 25}, {9, 23}, {7, 20}, {5, 16}, {4, 11}, {4, 7}, {5, 2}, {7, -2},
+    {9, -5}, {11, -7},
+    // ')'
+    {M | 3, 25}, {5, 23}, {7, 20}, {9, 16}, {10, 11}, {10, 7}, {9, 2}, {7, -2},
+    {5, -5}, {3, -7},
+    // '*'
+    {M | 8, 21}, {8, 9}, {M | 3, 18}, {13, 12}, {M | 13, 18}, {3, 12},
+    // '+'
+    {M | 13, 18}, {13, 0}, {M | 4, 9}, {22, 9},
+    // ','
+    {M | 6, 1}, {5, 0}, {4, 1}, {5, 2}, {6, 1}, {6, -1}, {5, -3}, {4, -4},
+    // '-'
+    {M | 4, 9}, {22, 9},
+    // '.'
+    {M | 5, 2}, {4, 1}, {5, 0}, {6, 1}, {5, 2},
+    // '/'
+    {M | 20, 25}, {2, -7},
+    // '0'
+    {M | 9, 21}, {6, 20}, {4, 17}, {3, 12}, {3, 9}, {4, 4}, {6, 1}, {9, 0},
+    {11, 0}, {14, 1}, {16, 4}, {17, 9}, {17, 12}, {16, 17}, {14, 20}, {11, 21},
+    {9, 21},
+    // '1'
+    {M | 6, 17}, {8, 18}, {11, 21}, {11, 0},
+    // '2'
+    {M | 4, 16}, {4, 17}, {5, 19}, {6, 20}, {8, 21}, {12, 21}, {14, 20},
+    {15, 19}, {16, 17}, {16, 15}, {15, 13}, {13, 10}, {3, 0}, {17, 0},
+    // '3'
+    {M | 5, 21}, {16, 21}, {10, 13}, {13, 13}, {15, 12}, {16, 11}, {17, 8},
+    {17, 6}, {16, 3}, {14, 1}, {11, 0}, {8, 0}, {5, 1}, {4, 2}, {3, 4},
+    // '4'
+    {M | 13, 21}, {3, 7}, {18, 7}, {M | 13, 21}, {13, 0},
+    // '5'
+    {M | 15, 21}, {5, 21}, {4, 12}, {5, 13}, {8, 14}, {11, 14}, {14, 13},
+    {16, 11}, {17, 8}, {17, 6}, {16, 3}, {14, 1}, {11, 0}, {8, 0}, {5, 1},
+    {4, 2}, {3, 4},
+    // '6'
+    {M | 16, 18}, {15, 20}, {12, 21}, {10, 21}, {7, 20}, {5, 17}, {4, 12},
+    {4, 7}, {5, 3}, {7, 1}, {10, 0}, {11, 0}, {14, 1}, {16, 3}, {17, 6},
+    {17, 7}, {16, 10}, {14, 12}, {11, 13}, {10, 13}, {7, 12}, {5, 10}, {4, 7},
+    // '7'
+    {M | 17, 21}, {7, 0}, {M | 3, 21}, {17, 21},
+    // '8'
+    {M | 8, 21}, {5, 20}, {4, 18}, {4, 16}, {5, 14}, {7, 13}, {11, 12},
+    {14, 11}, {16, 9}, {17, 7}, {17, 4}, {16, 2}, {15, 1}, {12, 0}, {8, 0},
+    {5, 1}, {4, 2}, {3, 4}, {3, 7}, {4, 9}, {6, 11}, {9, 12}, {13, 13},
+    {15, 14}, {16, 16}, {16, 18}, {15, 20}, {12, 21}, {8, 21},
+    // '9'
+    {M | 16, 14}, {15, 11}, {13, 9}, {10, 8}, {9, 8}, {6, 9}, {4, 11}, {3, 14},
+    {3, 15}, {4, 18}, {6, 20}, {9, 21}, {10, 21}, {13, 20}, {15, 18}, {16, 14},
+    {16, 9}, {15, 4}, {13, 1}, {10, 0}, {8, 0}, {5, 1}, {4, 3},
+    // ':'
+    {M | 5, 14}, {4, 13}, {5, 12}, {6, 13}, {5, 14}, {M | 5, 2}, {4, 1}, {5, 0},
+    {6, 1}, {5, 2},
+    // ';'
+    {M | 5, 14}, {4, 13}, {5, 12}, {6, 13}, {5, 14}, {M | 6, 1}, {5, 0}, {4, 1},
+    {5, 2}, {6, 1}, {6, -1}, {5, -3}, {4, -4},
+    // '<'
+    {M | 20, 18}, {4, 9}, {20, 0},
+    // '='
+    {M | 4, 12}, {22, 12}, {M | 4, 6}, {22, 6},
+    // '>'
+    {M | 4, 18}, {20, 9}, {4, 0},
+    // '?'
+    {M | 3, 16}, {3, 17}, {4, 19}, {5, 20}, {7, 21}, {11, 21}, {13, 20},
+    {14, 19}, {15, 17}, {15, 15}, {14, 13}, {13, 12}, {9, 10}, {9, 7},
+    {M | 9, 2}, {8, 1}, {9, 0}, {10, 1}, {9, 2},
+    // '@'
+    {M | 18, 13}, {17, 15}, {15, 16}, {12, 16}, {10, 15}, {9, 14}, {8, 11},
+    {8, 8}, {9, 6}, {11, 5}, {14, 5}, {16, 6}, {17, 8}, {M | 12, 16}, {10, 14},
+    {9, 11}, {9, 8}, {10, 6}, {11, 5}, {M | 18, 16}, {17, 8}, {17, 6}, {19, 5},
+    {21, 5}, {23, 7}, {24, 10}, {24, 12}, {23, 15}, {22, 17}, {20, 19},
+    {18, 20}, {15, 21}, {12, 21}, {9, 20}, {7, 19}, {5, 17}, {4, 15}, {3, 12},
+    {3, 9}, {4, 6}, {5, 4}, {7, 2}, {9, 1}, {12, 0}, {15, 0}, {18, 1}, {20, 2},
+    {21, 3}, {M | 19, 16}, {18, 8}, {18, 6}, {19, 5},
+    // 'A'
+    {M | 9, 21}, {1, 0}, {M | 9, 21}, {17, 0}, {M | 4, 7}, {14, 7},
+    // 'B'
+    {M | 4, 21}, {4, 0}, {M | 4, 21}, {13, 21}, {16, 20}, {17, 19}, {18, 17},
+    {18, 15}, {17, 13}, {16, 12}, {13, 11}, {M | 4, 11}, {13, 11}, {16, 10},
+    {17, 9}, {18, 7}, {18, 4}, {17, 2}, {16, 1}, {13, 0}, {4, 0},
+    // 'C'
+    {M | 18, 16}, {17, 18}, {15, 20}, {13, 21}, {9, 21}, {7, 20}, {5, 18},
+    {4, 16}, {3, 13}, {3, 8}, {4, 5}, {5, 3}, {7, 1}, {9, 0}, {13, 0}, {15, 1},
+    {17, 3}, {18, 5},
+    // 'D'
+    {M | 4, 21}, {4, 0}, {M | 4, 21}, {11, 21}, {14, 20}, {16, 18}, {17, 16},
+    {18, 13}, {18, 8}, {17, 5}, {16, 3}, {14, 1}, {11, 0}, {4, 0},
+    // 'E'
+    {M | 4, 21}, {4, 0}, {M | 4, 21}, {17, 21}, {M | 4, 11}, {12, 11},
+    {M | 4, 0}, {17, 0},
+    // 'F'
+    {M | 4, 21}, {4, 0}, {M | 4, 21}, {17, 21}, {M | 4, 11}, {12, 11},
+    // 'G'
+    {M | 18, 16}, {17, 18}, {15, 20}, {13, 21}, {9, 21}, {7, 20}, {5, 18},
+    {4, 16}, {3, 13}, {3, 8}, {4, 5}, {5, 3}, {7, 1}, {9, 0}, {13, 0}, {15, 1},
+    {17, 3}, {18, 5}, {18, 8}, {M | 13, 8}, {18, 8},
+    // 'H'
+    {M | 4, 21}, {4, 0}, {M | 18, 21}, {18, 0}, {M | 4, 11}, {18, 11},
+    // 'I'
+    {M | 4, 21}, {4, 0},
+    // 'J'
+    {M | 12, 21}, {12, 5}, {11, 2}, {10, 1}, {8, 0}, {6, 0}, {4, 1}, {3, 2},
+    {2, 5}, {2, 7},
+    // 'K'
+    {M | 4, 21}, {4, 0}, {M | 18, 21}, {4, 7}, {M | 9, 12}, {18, 0},
+    // 'L'
+    {M | 4, 21}, {4, 0}, {M | 4, 0}, {16, 0},
+    // 'M'
+    {M | 4, 21}, {4, 0}, {M | 4, 21}, {12, 0}, {M | 20, 21}, {12, 0},
+    {M | 20, 21}, {20, 0},
+    // 'N'
+    {M | 4, 21}, {4, 0}, {M | 4, 21}, {18, 0}, {M | 18, 21}, {18, 0},
+    // 'O'
+    {M | 9, 21}, {7, 20}, {5, 18}, {4, 16}, {3, 13}, {3, 8}, {4, 5}, {5, 3},
+    {7, 1}, {9, 0}, {13, 0}, {15, 1}, {17, 3}, {18, 5}, {19, 8}, {19, 13},
+    {18, 16}, {17, 18}, {15, 20}, {13, 21}, {9, 21},
+    // 'P'
+    {M | 4, 21}, {4, 0}, {M | 4, 21}, {13, 21}, {16, 20}, {17, 19}, {18, 17},
+    {18, 14}, {17, 12}, {16, 11}, {13, 10}, {4, 10},
+    // 'Q'
+    {M | 9, 21}, {7, 20}, {5, 18}, {4, 16}, {3, 13}, {3, 8}, {4, 5}, {5, 3},
+    {7, 1}, {9, 0}, {13, 0}, {15, 1}, {17, 3}, {18, 5}, {19, 8}, {19, 13},
+    {18, 16}, {17, 18}, {15, 20}, {13, 21}, {9, 21}, {M | 12, 4}, {18, -2},
+    // 'R'
+    {M | 4, 21}, {4, 0}, {M | 4, 21}, {13, 21}, {16, 20}, {17, 19}, {18, 17},
+    {18, 15}, {17, 13}, {16, 12}, {13, 11}, {4, 11}, {M | 11, 11}, {18, 0},
+    // 'S'
+    {M | 17, 18}, {15, 20}, {12, 21}, {8, 21}, {5, 20}, {3, 18}, {3, 16},
+    {4, 14}, {5, 13}, {7, 12}, {13, 10}, {15, 9}, {16, 8}, {17, 6}, {17, 3},
+    {15, 1}, {12, 0}, {8, 0}, {5, 1}, {3, 3},
+    // 'T'
+    {M | 8, 21}, {8, 0}, {M | 1, 21}, {15, 21},
+    // 'U'
+    {M | 4, 21}, {4, 6}, {5, 3}, {7, 1}, {10, 0}, {12, 0}, {15, 1}, {17, 3},
+    {18, 6}, {18, 21},
+    // 'V'
+    {M | 1, 21}, {9, 0}, {M | 17, 21}, {9, 0},
+    // 'W'
+    {M | 2, 21}, {7, 0}, {M | 12, 21}, {7, 0}, {M | 12, 21}, {17, 0},
+    {M | 22, 21}, {17, 0},
+    // 'X'
+    {M | 3, 21}, {17, 0}, {M | 17, 21}, {3, 0},
+    // 'Y'
+    {M | 1, 21}, {9, 11}, {9, 0}, {M | 17, 21}, {9, 11},
+    // 'Z'
+    {M | 17, 21}, {3, 0}, {M | 3, 21}, {17, 21}, {M | 3, 0}, {17, 0},
+    // '['
+    {M | 4, 25}, {4, -7}, {M | 5, 25}, {5, -7}, {M | 4, 25}, {11, 25},
+    {M | 4, -7}, {11, -7},
+    // '\\'
+    {M | 0, 21}, {14, -3},
+    // ']'
+    {M | 9, 25}, {9, -7}, {M | 10, 25}, {10, -7}, {M | 3, 25}, {10, 25},
+    {M | 3, -7}, {10, -7},
+    // '^'
+    {M | 6, 15}, {8, 18}, {10, 15}, {M | 3, 12}, {8, 17}, {13, 12}, {M | 8, 17},
+    {8, 0},
+    // '_'
+    {M | 0, -2}, {16, -2},
+    // '`'
+    {M | 6, 21}, {5, 20}, {4, 18}, {4, 16}, {5, 15}, {6, 16}, {5, 17},
+    // 'a'
+    {M | 15, 14}, {15, 0}, {M | 15, 11}, {13, 13}, {11, 14}, {8, 14}, {6, 13},
+    {4, 11}, {3, 8}, {3, 6}, {4, 3}, {6, 1}, {8, 0}, {11, 0}, {13, 1}, {15, 3},
+    // 'b'
+    {M | 4, 21}, {4, 0}, {M | 4, 11}, {6, 13}, {8, 14}, {11, 14}, {13, 13},
+    {15, 11}, {16, 8}, {16, 6}, {15, 3}, {13, 1}, {11, 0}, {8, 0}, {6, 1},
+    {4, 3},
+    // 'c'
+    {M | 15, 11}, {13, 13}, {11, 14}, {8, 14}, {6, 13}, {4, 11}, {3, 8}, {3, 6},
+    {4, 3}, {6, 1}, {8, 0}, {11, 0}, {13, 1}, {15, 3},
+    // 'd'
+    {M | 15, 21}, {15, 0}, {M | 15, 11}, {13, 13}, {11, 14}, {8, 14}, {6, 13},
+    {4, 11}, {3, 8}, {3, 6}, {4, 3}, {6, 1}, {8, 0}, {11, 0}, {13, 1}, {15, 3},
+    // 'e'
+    {M | 3, 8}, {15, 8}, {15, 10}, {14, 12}, {13, 13}, {11, 14}, {8, 14},
+    {6, 13}, {4, 11}, {3, 8}, {3, 6}, {4, 3}, {6, 1}, {8, 0}, {11, 0}, {13, 1},
+    {15, 3},
+    // 'f'
+    {M | 10, 21}, {8, 21}, {6, 20}, {5, 17}, {5, 0}, {M | 2, 14}, {9, 14},
+    // 'g'
+    {M | 15, 14}, {15, -2}, {14, -5}, {13, -6}, {11, -7}, {8, -7}, {6, -6},
+    {M | 15, 11}, {13, 13}, {11, 14}, {8, 14}, {6, 13}, {4, 11}, {3, 8}, {3, 6},
+    {4, 3}, {6, 1}, {8, 0}, {11, 0}, {13, 1}, {15, 3},
+    // 'h'
+    {M | 4, 21}, {4, 0}, {M | 4, 10}, {7, 13}, {9, 14}, {12, 14}, {14, 13},
+    {15, 10}, {15, 0},
+    // 'i'
+    {M | 3, 21}, {4, 20}, {5, 21}, {4, 22}, {3, 21}, {M | 4, 14}, {4, 0},
+    // 'j'
+    {M | 5, 21}, {6, 20}, {7, 21}, {6, 22}, {5, 21}, {M | 6, 14}, {6, -3},
+    {5, -6}, {3, -7}, {1, -7},
+    // 'k'
+    {M | 4, 21}, {4, 0}, {M | 14, 14}, {4, 4}, {M | 8, 8}, {15, 0},
+    // 'l'
+    {M | 4, 21}, {4, 0},
+    // 'm'
+    {M | 4, 14}, {4, 0}, {M | 4, 10}, {7, 13}, {9, 14}, {12, 14}, {14, 13},
+    {15, 10}, {15, 0}, {M | 15, 10}, {18, 13}, {20, 14}, {23, 14}, {25, 13},
+    {26, 10}, {26, 0},
+    // 'n'
+    {M | 4, 14}, {4, 0}, {M | 4, 10}, {7, 13}, {9, 14}, {12, 14}, {14, 13},
+    {15, 10}, {15, 0},
+    // 'o'
+    {M | 8, 14}, {6, 13}, {4, 11}, {3, 8}, {3, 6}, {4, 3}, {6, 1}, {8, 0},
+    {11, 0}, {13, 1}, {15, 3}, {16, 6}, {16, 8}, {15, 11}, {13, 13}, {11, 14},
+    {8, 14},
+    // 'p'
+    {M | 4, 14}, {4, -7}, {M | 4, 11}, {6, 13}, {8, 14}, {11, 14}, {13, 13},
+    {15, 11}, {16, 8}, {16, 6}, {15, 3}, {13, 1}, {11, 0}, {8, 0}, {6, 1},
+    {4, 3},
+    // 'q'
+    {M | 15, 14}, {15, -7}, {M | 15, 11}, {13, 13}, {11, 14}, {8, 14}, {6, 13},
+    {4, 11}, {3, 8}, {3, 6}, {4, 3}, {6, 1}, {8, 0}, {11, 0}, {13, 1}, {15, 3},
+    // 'r'
+    {M | 4, 14}, {4, 0}, {M | 4, 8}, {5, 11}, {7, 13}, {9, 14}, {12, 14},
+    // 's'
+    {M | 14, 11}, {13, 13}, {10, 14}, {7, 14}, {4, 13}, {3, 11}, {4, 9}, {6, 8},
+    {11, 7}, {13, 6}, {14, 4}, {14, 3}, {13, 1}, {10, 0}, {7, 0}, {4, 1},
+    {3, 3},
+    // 't'
+    {M | 5, 21}, {5, 4}, {6, 1}, {8, 0}, {10, 0}, {M | 2, 14}, {9, 14},
+    // 'u'
+    {M | 4, 14}, {4, 4}, {5, 1}, {7, 0}, {10, 0}, {12, 1}, {15, 4},
+    {M | 15, 14}, {15, 0},
+    // 'v'
+    {M | 2, 14}, {8, 0}, {M | 14, 14}, {8, 0},
+    // 'w'
+    {M | 3, 14}, {7, 0}, {M | 11, 14}, {7, 0}, {M | 11, 14}, {15, 0},
+    {M | 19, 14}, {15, 0},
+    // 'x'
+    {M | 3, 14}, {14, 0}, {M | 14, 14}, {3, 0},
+    // 'y'
+    {M | 2, 14}, {8, 0}, {M | 14, 14}, {8, 0}, {6, -4}, {4, -6}, {2, -7},
+    {1, -7},
+    // 'z'
+    {M | 14, 14}, {3, 0}, {M | 3, 14}, {14, 14}, {M | 3, 0}, {14, 0},
+    // '{'
+    {M | 9, 25}, {7, 24}, {6, 23}, {5, 21}, {5, 19}, {6, 17}, {7, 16}, {8, 14},
+    {8, 12}, {6, 10}, {M | 7, 24}, {6, 22}, {6, 20}, {7, 18}, {8, 17}, {9, 15},
+    {9, 13}, {8, 11}, {4, 9}, {8, 7}, {9, 5}, {9, 3}, {8, 1}, {7, 0}, {6, -2},
+    {6, -4}, {7, -6}, {M | 6, 8}, {8, 6}, {8, 4}, {7, 2}, {6, 1}, {5, -1},
+    {5, -3}, {6, -5}, {7, -6}, {9, -7},
+    // '|'
+    {M | 4, 25}, {4, -7},
+    // '}'
+    {M | 5, 25}, {7, 24}, {8, 23}, {9, 21}, {9, 19}, {8, 17}, {7, 16}, {6, 14},
+    {6, 12}, {8, 10}, {M | 7, 24}, {8, 22}, {8, 20}, {7, 18}, {6, 17}, {5, 15},
+    {5, 13}, {6, 11}, {10, 9}, {6, 7}, {5, 5}, {5, 3}, {6, 1}, {7, 0}, {8, -2},
+    {8, -4}, {7, -6}, {M | 8, 8}, {6, 6}, {6, 4}, {7, 2}, {8, 1}, {9, -1},
+    {9, -3}, {8, -5}, {7, -6}, {5, -7},
+    // '~'
+    {M | 3, 6}, {3, 8}, {4, 11}, {6, 12}, {8, 12}, {10, 11}, {14, 8}, {16, 7},
+    {18, 7}, {20, 8}, {21, 10}, {M | 3, 8}, {4, 10}, {6, 11}, {8, 11}, {10, 10},
+    {14, 7}, {16, 6}, {18, 6}, {20, 7}, {21, 10}, {21, 12},
+};
+
+#undef M
+
+// ASCII FONT_FIRST_CHAR..FONT_LAST_CHAR - start, count, width
+static const font_glyph_t font_glyphs[] PROGMEM = {
+    {0, 0, 16}, {0, 7, 10}, {7, 4, 16}, {11, 8, 21}, {19, 24, 20}, {43, 29, 24},
+    {72, 34, 26}, {106, 7, 10}, {113, 10, 14}, {123, 10, 14}, {133, 6, 16},
+    {139, 4, 26}, {143, 8, 10}, {151, 2, 26}, {153, 5, 10}, {158, 2, 22},
+    {160, 17, 20}, {177, 4, 20}, {181, 14, 20}, {195, 15, 20}, {210, 5, 20},
+    {215, 17, 20}, {232, 23, 20}, {255, 4, 20}, {259, 29, 20}, {288, 23, 20},
+    {311, 10, 10}, {321, 13, 10}, {334, 3, 24}, {337, 4, 26}, {341, 3, 24},
+    {344, 19, 18}, {363, 52, 27}, {415, 6, 18}, {421, 21, 21}, {442, 18, 21},
+    {460, 14, 21}, {474, 8, 19}, {482, 6, 18}, {488, 21, 21}, {509, 6, 22},
+    {515, 2, 8}, {517, 10, 16}, {527, 6, 21}, {533, 4, 17}, {537, 8, 24},
+    {545, 6, 22}, {551, 21, 22}, {572, 12, 21}, {584, 23, 22}, {607, 14, 21},
+    {621, 20, 20}, {641, 4, 16}, {645, 10, 22}, {655, 4, 18}, {659, 8, 24},
+    {667, 4, 20}, {671, 5, 18}, {676, 6, 20}, {682, 8, 14}, {690, 2, 14},
+    {692, 8, 14}, {700, 8, 16}, {708, 2, 16}, {710, 7, 10}, {717, 16, 19},
+    {733, 16, 19}, {749, 14, 18}, {763, 16, 19}, {779, 17, 18}, {796, 7, 12},
+    {803, 21, 19}, {824, 9, 19}, {833, 7, 8}, {840, 10, 10}, {850, 6, 17},
+    {856, 2, 8}, {858, 16, 30}, {874, 9, 19}, {883, 17, 19}, {900, 16, 19},
+    {916, 16, 19}, {932, 7, 13}, {939, 17, 17}, {956, 7, 12}, {963, 9, 19},
+    {972, 4, 16}, {976, 8, 22}, {984, 4, 17}, {988, 8, 16}, {996, 6, 17},
+    {1002, 37, 14}, {1039, 2, 8}, {1041, 37, 14}, {1078, 22, 24},
+};
+
+void font_glyph(uint8_t c, font_glyph_t *glyph) {
+  if (c < FONT_FIRST_CHAR || c > FONT_LAST_CHAR) {
+    c = '?';
+  }
+  memcpy_P(glyph, &font_glyphs[c - FONT_FIRST_CHAR], sizeof(font_glyph_t));
+}
+
+void font_vertex(uint16_t index, font_vertex_t *vertex) {
+  memcpy_P(vertex, &font_vertices[index], sizeof(font_vertex_t));
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * STROKE FONT
+ * ============================================================================
+ *
+ * Hershey Simplex, ASCII FONT_FIRST_CHAR..FONT_LAST_CHAR, in flash. Each
+ * glyph is a run of vertices drawn as connected strokes - a vertex with
+ * FONT_MOVE set in x starts a new stroke, and the first vertex of a glyph
+ * always does.
+ *
+ * Font units have the baseline at y = 0 and the left edge at x = 0. Capitals
+ * are FONT_CAP_HEIGHT high, and every vertex is within 0..width across and
+ * FONT_DESCENT..FONT_ASCENT up.
+ *
+ * ============================================================================
+ */
+
+#define FONT_FIRST_CHAR 32
+#define FONT_LAST_CHAR 126
+#define FONT_MOVE 0x80 // Vertex x bit - pen up before this vertex
+
+#define FONT_CAP_HEIGHT 21
+#define FONT_ASCENT 25
+#define FONT_DESCENT -7
+
+struct font_vertex_t {
+  uint8_t x; // 0..width, plus FONT_MOVE
+  int8_t y;
+};
+
+struct font_glyph_t {
+  uint16_t start; // First vertex
+  uint8_t count;  // Vertices - 0 for space
+  uint8_t width;  // Advance
+};
+
+// Copy the glyph for c out of flash - anything outside the font is drawn as
+// '?'
+void font_glyph(uint8_t c, font_glyph_t *glyph);
+
+// Copy vertex index (from a glyph's start) out of flash
+void font_vertex(uint16_t index, font_vertex_t *vertex);
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * FRAME STORAGE FORMATS
+ * ============================================================================
+ *
+ * FRAME_FORMAT_ABSOLUTE - every point is a 3 byte point_coord8_t. Points can
+ * be written in any order. This is the fallback format.
+ *
+ * FRAME_FORMAT_DELTA - one variable length record per point, written in order
+ * and decoded in order. Each record is relative to the previous point (the
+ * first point of a frame is relative to 0,0). The first byte is the tag:
+ *
+ *   1Bxxxyyy                  short delta, dx/dy -4..3           1 byte
+ *   01LBxxxx xxyyyyyy         medium delta, dx/dy -32..31        2 bytes
+ *   00LB0000 x y              absolute                           3 bytes
+ *   00000001 x y flags        raw - any reserved flag bits set   4 bytes
+ *
+ * B = BLANKING_BIT, L = LAST_POINT_BIT. Deltas wrap modulo 256, the same way
+ * the decoder adds them. Any other tag is invalid. Curve control points
+ * (CURVE_CONTROL_BIT) are stored as raw records.
+ *
+ * Typical outlines are mostly short and medium records, so a delta frame
+ * takes 1-2 bytes per point instead of 3.
+ *
+ * FRAME_FORMAT_PROGRAM - display list bytecode that outputs the points (see
+ * program.h). The point count is only known once the program has been run.
+ *
+ * FRAME_FORMAT_SPRITES - a list of instances of sprites stored in flash (see
+ * sprite.h).
+ *
+ * FRAME_FORMAT_TEXT - runs of characters drawn in the flash stroke font (see
+ * text.h).
+ *
+ * FRAME_FORMAT_GENERATOR - parametric figures and test patterns (see
+ * generator.h).
+ *
+ * Programs, sprite lists, text and generators are generated formats - they are sent as raw
+ * bytes and their points are worked out as the frame is read.
+ *
+ * ============================================================================
+ */
+
+enum frame_format_t : uint8_t {
+  FRAME_FORMAT_ABSOLUTE = 0,
+  FRAME_FORMAT_DELTA = 1,
+  FRAME_FORMAT_PROGRAM = 2,
+  FRAME_FORMAT_SPRITES = 3,
+  FRAME_FORMAT_TEXT = 4,
+  FRAME_FORMAT_GENERATOR = 5,
+};
+
+#define FRAME_FORMAT_IS_GENERATED(format) ((format) >= FRAME_FORMAT_PROGRAM)
+
+#define FRAME_RECORD_MAX_SIZE 4 // Largest delta record (raw)
+
+#define FRAME_TAG_SHORT 0x80
+#define FRAME_TAG_MEDIUM 0x40
+#define FRAME_TAG_RAW 0x01
+#define FRAME_TAG_FLAG_SHIFT 2 // L and B position in medium/absolute tags
+
+// Flags that fit in a tag; anything else needs a raw record
+#define FRAME_TAG_FLAGS (LAST_POINT_BIT | BLANKING_BIT)
+
+// Encode point after prev into out (FRAME_RECORD_MAX_SIZE bytes)
+// Returns the record length
+inline uint8_t frame_encode_point(point_coord8_t prev, point_coord8_t point,
+                                  uint8_t *out) {
+  int8_t dx = (int8_t)(point.x - prev.x);
+  int8_t dy = (int8_t)(point.y - prev.y);
+
+  if (point.flags & ~FRAME_TAG_FLAGS) {
+    out[0] = FRAME_TAG_RAW;
+    out[1] = point.x;
+    out[2] = point.y;
+    out[3] = point.flags;
+    return 4;
+  }
+
+  if (!(point.flags & LAST_POINT_BIT) && dx >= -4 && dx <= 3 && dy >= -4 &&
+      dy <= 3) {
+    out[0] = FRAME_TAG_SHORT | (point.flags & BLANKING_BIT) |
+             ((dx & 0x07) << 3) | (dy & 0x07);
+    return 1;
+  }
+
+  uint8_t tag_flags = point.flags >> FRAME_TAG_FLAG_SHIFT; // 0b00LB0000
+
+  if (dx >= -32 && dx <= 31 && dy >= -32 && dy <= 31) {
+    out[0] = FRAME_TAG_MEDIUM | tag_flags | ((dx & 0x3F) >> 2);
+    out[1] = ((dx & 0x03) << 6) | (dy & 0x3F);
+    return 2;
+  }
+
+  out[0] = tag_flags;
+  out[1] = point.x;
+  out[2] = point.y;
+  return 3;
+}
+
+// Length of the record starting with tag, 0 if the tag is invalid
+inline uint8_t frame_record_size(uint8_t tag) {
+  if (tag & FRAME_TAG_SHORT) {
+    return 1;
+  }
+  if (tag & FRAME_TAG_MEDIUM) {
+    return 2;
+  }
+  if ((tag & 0x0F) == 0) {
+    return 3;
+  }
+  if (tag == FRAME_TAG_RAW) {
+    return 4;
+  }
+  return 0;
+}
+
+// Decode one record of at most available bytes. point holds the previous
+// point on entry and the decoded point on return.
+// Returns the record length, 0 if the record is invalid or truncated
+inline uint8_t frame_decode_point(const uint8_t *in, uint16_t available,
+                                  point_coord8_t *point) {
+  if (available == 0) {
+    return 0;
+  }
+
+  uint8_t tag = in[0];
+  uint8_t size = frame_record_size(tag);
+  if (size == 0 || size > available) {
+    return 0;
+  }
+
+  switch (size) {
+  case 1:
+    // Sign extend the 3 bit fields
+    point->x += (int8_t)(tag << 2) >> 5;
+    point->y += (int8_t)(tag << 5) >> 5;
+    point->flags = tag & BLANKING_BIT;
+    break;
+  case 2:
+    point->x += (int8_t)(((tag & 0x0F) << 4) | ((in[1] >> 4) & 0x0C)) >> 2;
+    point->y += (int8_t)(in[1] << 2) >> 2;
+    point->flags = (tag << FRAME_TAG_FLAG_SHIFT) & FRAME_TAG_FLAGS;
+    break;
+  case 3:
+    point->x = in[1];
+    point->y = in[2];
+    point->flags = (tag << FRAME_TAG_FLAG_SHIFT) & FRAME_TAG_FLAGS;
+    break;
+  default:
+    point->x = in[1];
+    point->y = in[2];
+    point->flags = in[3];
+    break;
+  }
+
+  return size;
+}
@@ -0,0 +1,220 @@
+#include "generator.h"
+#include "sprite.h"
+#include "transform.h"
+#include <avr/pgmspace.h>
+
+#define GENERATOR_ONE 16384    // 1.0 in Q1.14
+#define GENERATOR_TEST_SHIFT 8 // Test pattern units (+/-64) to Q1.14
+
+// Test pattern, +/-64 across the box
+static const sprite_point_t test_points[] PROGMEM = {
+    // Border
+    {-64, -64, BLANKING_BIT}, {64, -64, 0}, {64, 64, 0}, {-64, 64, 0},
+    {-64, -64, 0},
+    // Circle - a full turn arc
+    {48, 0, BLANKING_BIT}, {0, 0, ARC_CENTRE_BIT}, {48, 0, 0},
+    // Diamond
+    {32, 0, BLANKING_BIT}, {0, 32, 0}, {-32, 0, 0}, {0, -32, 0}, {32, 0, 0},
+    // Centre cross
+    {-16, 0, BLANKING_BIT}, {16, 0, 0}, {0, -16, BLANKING_BIT}, {0, 16, 0}};
+
+#define GENERATOR_TEST_POINTS (sizeof(test_points) / sizeof(sprite_point_t))
+
+static bool generator_valid(const generator_t &g) {
+  switch (g.kind) {
+  case GENERATOR_LISSAJOUS:
+  case GENERATOR_SPIRAL:
+    return g.points > 0;
+  case GENERATOR_POLYGON:
+    return g.a >= 2;
+  case GENERATOR_GRID:
+    return g.a > 0 || g.b > 0;
+  case GENERATOR_TEST:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Points in one loop of g
+static uint16_t generator_loop_points(const generator_t &g) {
+  switch (g.kind) {
+  case GENERATOR_LISSAJOUS:
+  case GENERATOR_SPIRAL:
+    return g.points + 1;
+  case GENERATOR_POLYGON:
+    return g.a + 1;
+  case GENERATOR_GRID:
+    return 2 * (g.a + g.b);
+  default:
+    return GENERATOR_TEST_POINTS;
+  }
+}
+
+// Divides the phase step per point - a whole turn over the loop, b turns
+// for a star
+static uint8_t generator_divisor(const generator_t &g) {
+  switch (g.kind) {
+  case GENERATOR_LISSAJOUS:
+  case GENERATOR_SPIRAL:
+    return g.points;
+  case GENERATOR_POLYGON:
+    return g.a;
+  default:
+    return 1;
+  }
+}
+
+static uint32_t generator_turns(const generator_t &g) {
+  return g.kind == GENERATOR_POLYGON && g.b > 1 ? g.b : 1;
+}
+
+// Sine of a 16 bit phase (65536 per turn) in Q1.14, interpolated
+static int16_t generator_sin(uint16_t phase) {
+  int32_t s0 = transform_sin(phase >> 8);
+  int32_t s1 = transform_sin((phase >> 8) + 1);
+  return s0 + (((s1 - s0) * (phase & 0xFF)) >> 8);
+}
+
+// i of n evenly spread over -1..1 in Q1.14
+static int32_t generator_spread(uint8_t i, uint8_t n) {
+  if (n < 2) {
+    return 0;
+  }
+  return -GENERATOR_ONE + (2L * GENERATOR_ONE * i) / (n - 1);
+}
+
+// Centre plus radius times unit (Q1.14), clamped
+static inline uint8_t generator_place(uint8_t centre, uint8_t radius,
+                                      int32_t unit) {
+  int32_t out = centre + ((radius * unit + (GENERATOR_ONE / 2)) >> 14);
+  return constrain(out, 0, 255);
+}
+
+bool generator_count_points(const uint8_t *data, uint16_t length,
+                            uint16_t *points) {
+  uint32_t total = 0;
+  for (uint16_t pos = 0; pos < length; pos += sizeof(generator_t)) {
+    if (pos + sizeof(generator_t) > length) {
+      return false;
+    }
+
+    generator_t g;
+    memcpy(&g, data + pos, sizeof(generator_t));
+    if (!generator_valid(g)) {
+      return false;
+    }
+    total += (uint32_t)generator_loop_points(g) * (g.loops ? g.loops : 1);
+    if (total > GENERATOR_MAX_POINTS) {
+      return false;
+    }
+  }
+  *points = total;
+  return true;
+}
+
+bool generator_next_point(const uint8_t *data, uint16_t length, uint16_t *pos,
+                          generator_state_t *state, point_coord8_t *point) {
+  for (; *pos + sizeof(generator_t) <= length;
+       *pos += sizeof(generator_t), state->reset()) {
+    generator_t g;
+    memcpy(&g, data + *pos, sizeof(generator_t));
+    if (!generator_valid(g)) {
+      continue;
+    }
+
+    uint16_t count = generator_loop_points(g);
+    if (state->step >= count) {
+      state->step = 0;
+      state->loop++;
+    }
+    if (state->loop >= (g.loops ? g.loops : 1)) {
+      continue;
+    }
+
+    bool last = state->step == count - 1;
+    if (state->step == 0) {
+      uint8_t divisor = generator_divisor(g);
+      uint32_t turns = generator_turns(g) << 16;
+      state->phase = 0;
+      state->increment = turns / divisor;
+      state->remainder = turns % divisor;
+      state->error = 0;
+    } else {
+      uint16_t error = state->error + state->remainder;
+      uint8_t divisor = generator_divisor(g);
+      state->phase += state->increment;
+      if (error >= divisor) {
+        error -= divisor;
+        state->phase++;
+      }
+      state->error = error;
+    }
+
+    uint8_t angle = g.angle + g.drift * state->loop;
+    uint16_t rotation = (uint16_t)angle << 8;
+    uint16_t theta;
+    uint8_t flags = 0;
+    int32_t u, v;
+
+    switch (g.kind) {
+    case GENERATOR_LISSAJOUS:
+      u = generator_sin(g.a * state->phase);
+      v = generator_sin(g.b * state->phase + rotation);
+      break;
+
+    case GENERATOR_SPIRAL: {
+      int32_t radius = last ? 0x10000L : state->phase;
+      theta = g.a * state->phase + rotation;
+      u = (generator_sin(theta + 0x4000) * radius) >> 16;
+      v = (generator_sin(theta) * radius) >> 16;
+      if (state->step == 0) {
+        flags = BLANKING_BIT;
+      }
+      break;
+    }
+
+    case GENERATOR_POLYGON:
+      theta = state->phase + rotation;
+      u = generator_sin(theta + 0x4000);
+      v = generator_sin(theta);
+      break;
+
+    case GENERATOR_GRID: {
+      // Lines drawn back and forth - blanked to the start, lit to the end
+      uint16_t line = state->step >> 1;
+      bool end = state->step & 1;
+      int32_t across = ((line & 1) ^ end) ? GENERATOR_ONE : -GENERATOR_ONE;
+      if (line < g.a) {
+        u = generator_spread(line, g.a);
+        v = across;
+      } else {
+        u = across;
+        v = generator_spread(line - g.a, g.b);
+      }
+      flags = end ? 0 : BLANKING_BIT;
+      break;
+    }
+
+    default: {
+      sprite_point_t p;
+      memcpy_P(&p, &test_points[state->step], sizeof(sprite_point_t));
+      u = (int32_t)p.x << GENERATOR_TEST_SHIFT;
+      v = (int32_t)p.y << GENERATOR_TEST_SHIFT;
+      flags = p.flags;
+      break;
+    }
+    }
+
+    // Reached with a blanked move
+    if (state->step == 0 && state->loop == 0) {
+      flags |= BLANKING_BIT;
+    }
+    state->step++;
+
+    *point = point_coord8_t(generator_place(g.x, g.rx, u),
+                            generator_place(g.y, g.ry, v), flags);
+    return true;
+  }
+  return false;
+}
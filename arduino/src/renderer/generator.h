@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * GENERATORS
+ * ============================================================================
+ *
+ * A FRAME_FORMAT_GENERATOR frame holds a few parametric figures, 11 bytes
+ * each, that are worked out point by point as the frame is drawn:
+ *
+ *   kind x y rx ry points loops a b angle drift
+ *
+ * x/y is the centre and rx/ry the radii in coord8. Each figure is drawn
+ * loops times (0 counts as 1), with angle advanced by drift every loop, and
+ * is reached with a blanked move. Angles are 256 per turn.
+ *
+ *   GENERATOR_LISSAJOUS   x = sin(a t), y = sin(b t + angle), points
+ *                         segments per loop. Loops join up, so drift rolls
+ *                         the figure round
+ *   GENERATOR_SPIRAL      a turns out from the centre in points segments,
+ *                         starting at angle. Each loop starts back at the
+ *                         centre
+ *   GENERATOR_POLYGON     a sided polygon, or a star if b > 1 (every bth
+ *                         vertex), first vertex at angle
+ *   GENERATOR_GRID        a vertical and b horizontal lines across the
+ *                         box, drawn back and forth
+ *   GENERATOR_TEST        ILDA style test pattern filling the box - border,
+ *                         circle, diamond and centre cross
+ *
+ * Unused fields are ignored. t runs through a 16 bit phase accumulator,
+ * stepped by a full turn / points with the remainder carried like a line
+ * DDA, so it never drifts and lands back on a whole turn at the end of a
+ * loop. Sine comes from the transform table interpolated to the
+ * accumulator's 1/65536 turn.
+ *
+ * A pass always outputs the same points, so generator frames play back
+ * from the step cache like any other. Points off the field are clamped.
+ * Eleven bytes can ask for 65k points, so a frame whose figures add up to
+ * more than GENERATOR_MAX_POINTS a pass is rejected when committed.
+ *
+ * ============================================================================
+ */
+
+#define GENERATOR_MAX_POINTS 1024 // Per pass, like PROGRAM_MAX_POINTS
+
+enum generator_kind_t : uint8_t {
+  GENERATOR_LISSAJOUS,
+  GENERATOR_SPIRAL,
+  GENERATOR_POLYGON,
+  GENERATOR_GRID,
+  GENERATOR_TEST,
+  GENERATOR_KIND_COUNT
+};
+
+struct generator_t {
+  uint8_t kind;
+  uint8_t x, y;
+  uint8_t rx, ry;
+  uint8_t points;
+  uint8_t loops;
+  uint8_t a, b;
+  uint8_t angle;
+  uint8_t drift;
+};
+
+// Position within a figure - part of frame_cursor_t
+struct generator_state_t {
+  uint16_t step;      // Next point of the loop
+  uint16_t phase;     // t at step
+  uint16_t increment; // Whole part of the phase step
+  uint8_t remainder;  // Fraction of the phase step, over the divisor
+  uint8_t error;      // Fraction carried, over the divisor
+  uint8_t loop;
+
+  inline void reset() {
+    step = 0;
+    phase = 0;
+    increment = 0;
+    remainder = 0;
+    error = 0;
+    loop = 0;
+  }
+};
+
+// Points one pass of the figures in data (length bytes) outputs
+// Returns false if a record is truncated or has a bad kind or parameters, or
+// the figures add up to more than GENERATOR_MAX_POINTS
+bool generator_count_points(const uint8_t *data, uint16_t length,
+                            uint16_t *points);
+
+// Next point of the figures in data. pos is the byte offset of the current
+// figure, 0 with state reset to start.
+// Returns false at the end of the figures
+bool generator_next_point(const uint8_t *data, uint16_t length, uint16_t *pos,
+                          generator_state_t *state, point_coord8_t *point);
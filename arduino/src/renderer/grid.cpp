@@ -0,0 +1,95 @@
+#include "grid.h"
+#include <EEPROM.h>
+
+static_assert(GRID_EEPROM_BYTES <= 255, "grid clear counts bytes in 8 bits");
+static_assert(GRID_NODES * GRID_NODES <= 32, "grid clear skip mask is 32 bit");
+
+// The cell grid_apply last read, and the background clear
+static struct {
+  uint8_t col; // GRID_NODES when nothing is cached
+  uint8_t row;
+  grid_node_t nodes[4]; // n00, n10, n01, n11
+
+  uint8_t clear_next; // Next grid byte to zero, 0 when not clearing
+  uint32_t clear_skip; // Nodes written since the clear started
+} grid = {GRID_NODES, 0, {}, 0, 0};
+
+static inline uint16_t grid_node_address(uint8_t col, uint8_t row) {
+  return GRID_EEPROM_ADDRESS + 1 +
+         (row * GRID_NODES + col) * (uint16_t)GRID_NODE_BYTES;
+}
+
+bool grid_is_loaded() {
+  return EEPROM.read(GRID_EEPROM_ADDRESS) == GRID_EEPROM_MAGIC;
+}
+
+grid_node_t grid_get_node(uint8_t col, uint8_t row) {
+  grid_node_t node;
+  EEPROM.get(grid_node_address(col, row), node);
+  return node;
+}
+
+void grid_set_node(uint8_t col, uint8_t row, grid_node_t node) {
+  if (!grid_is_loaded() && grid.clear_next == 0) {
+    grid.clear_next = 1;
+    grid.clear_skip = 0;
+  }
+  if (grid.clear_next != 0) {
+    grid.clear_skip |= 1UL << (row * GRID_NODES + col);
+  }
+  EEPROM.put(grid_node_address(col, row), node);
+  grid.col = GRID_NODES;
+}
+
+bool grid_poll() {
+  if (grid.clear_next == 0 || !eeprom_is_ready()) {
+    return false;
+  }
+
+  if (grid.clear_next < GRID_EEPROM_BYTES) {
+    uint8_t node = (grid.clear_next - 1) / GRID_NODE_BYTES;
+    if (!(grid.clear_skip & (1UL << node))) {
+      EEPROM.update(GRID_EEPROM_ADDRESS + grid.clear_next, 0);
+    }
+    grid.clear_next++;
+    return false;
+  }
+
+  // The magic byte goes last, so a reset part way through clears again
+  grid.clear_next = 0;
+  EEPROM.write(GRID_EEPROM_ADDRESS, GRID_EEPROM_MAGIC);
+  grid.col = GRID_NODES;
+  return true;
+}
+
+static inline int16_t grid_lerp(int16_t a, int16_t b, int16_t f) {
+  return a + (((int32_t)(int16_t)(b - a) * f) >> GRID_CELL_SHIFT);
+}
+
+point_q12_4_t grid_apply(point_q12_4_t point) {
+  uint16_t x = constrain(point.x, 0, GRID_MAX_OUTPUT);
+  uint16_t y = constrain(point.y, 0, GRID_MAX_OUTPUT);
+  uint8_t col = x >> GRID_CELL_SHIFT;
+  uint8_t row = y >> GRID_CELL_SHIFT;
+  int16_t fx = x & (GRID_CELL_SIZE - 1);
+  int16_t fy = y & (GRID_CELL_SIZE - 1);
+
+  // Steps mostly stay in one cell - EEPROM is read when they leave it
+  if (col != grid.col || row != grid.row) {
+    grid.col = col;
+    grid.row = row;
+    grid.nodes[0] = grid_get_node(col, row);
+    grid.nodes[1] = grid_get_node(col + 1, row);
+    grid.nodes[2] = grid_get_node(col, row + 1);
+    grid.nodes[3] = grid_get_node(col + 1, row + 1);
+  }
+  const grid_node_t *n = grid.nodes;
+
+  int16_t dx = grid_lerp(grid_lerp(n[0].x, n[1].x, fx),
+                         grid_lerp(n[2].x, n[3].x, fx), fy);
+  int16_t dy = grid_lerp(grid_lerp(n[0].y, n[1].y, fx),
+                         grid_lerp(n[2].y, n[3].y, fx), fy);
+
+  return point_q12_4_t(constrain(x + dx, 0, GRID_MAX_OUTPUT),
+                       constrain(y + dy, 0, GRID_MAX_OUTPUT));
+}
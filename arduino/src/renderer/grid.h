@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../config.h"
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * GEOMETRIC CORRECTION GRID
+ * ============================================================================
+ *
+ * Corrects keystone, pincushion and similar distortion of the projection.
+ * A GRID_NODES x GRID_NODES grid of x/y offsets is spread evenly over the
+ * DAC range, and every output step is moved by the offset interpolated
+ * bilinearly from the four nodes around it:
+ *
+ *   top    = n00 + (n10 - n00) * fx
+ *   bottom = n01 + (n11 - n01) * fx
+ *   offset = top + (bottom - top) * fy
+ *
+ * fx/fy are the position inside the cell in 1/GRID_CELL_SIZE ths. It runs
+ * after interpolation, so long lines bend with the correction instead of
+ * only having their end points moved.
+ *
+ * The grid lives in EEPROM (GRID_EEPROM_ADDRESS), so it keeps its values
+ * over a reset. Only the four nodes of the cell the last step was in are
+ * held in RAM - EEPROM is read again when a step crosses into another cell.
+ * Offsets are in DAC counts, node (col, row) is at x = col * GRID_CELL_SIZE,
+ * y = row * GRID_CELL_SIZE.
+ *
+ * The first node written to an unwritten EEPROM starts zeroing the rest of
+ * the grid. An EEPROM byte takes 3.4 ms to write, so grid_poll zeroes one
+ * per loop pass rather than holding up the renderer for the whole grid;
+ * the grid is loaded once it has finished.
+ *
+ * ============================================================================
+ */
+
+#define GRID_CELL_SHIFT 10
+#define GRID_CELL_SIZE (1 << GRID_CELL_SHIFT)
+#define GRID_NODES ((0x1000 >> GRID_CELL_SHIFT) + 1) // Both edges included
+#define GRID_MAX_OFFSET 511                           // DAC counts, either way
+#define GRID_MAX_OUTPUT 0x0FFF                        // DAC full scale
+
+// EEPROM layout: magic byte then nodes row by row, x then y (int16 each)
+#define GRID_EEPROM_MAGIC 0x47
+#define GRID_NODE_BYTES 4
+#define GRID_EEPROM_BYTES (1 + GRID_NODES * GRID_NODES * GRID_NODE_BYTES)
+
+struct grid_node_t {
+  int16_t x;
+  int16_t y;
+};
+
+// True once a grid has been written - an unwritten EEPROM holds no grid
+bool grid_is_loaded();
+
+grid_node_t grid_get_node(uint8_t col, uint8_t row);
+
+// Write one node. The first write to an unwritten EEPROM starts zeroing the
+// other nodes.
+void grid_set_node(uint8_t col, uint8_t row, grid_node_t node);
+
+// Call every loop pass - zeroes the next grid byte if the EEPROM is free.
+// True once the zeroing has finished and the grid is loaded.
+bool grid_poll();
+
+// Corrected step
+point_q12_4_t grid_apply(point_q12_4_t point);
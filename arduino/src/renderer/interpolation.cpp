@@ -1,4 +1,5 @@
 #include "interpolation.h"
+#include "cordic.h"
 
 // TODO: add validation for all parameters
 
@@ -17,29 +18,27 @@ bool interp_clear() {
   interp.state = INTERP_STATE_FINISHED;
   return true;
 }
-bool interp_init(transition_t *transition, uint8_t step_size,
-                 uint8_t acc_factor, uint8_t dec_factor) {
+bool interp_init(transition_t *transition,
+                 const interp_settings_t &settings) {
+  PROFILE_ZONE(PROFILE_INTERP_INIT);
 
   DEBUG_VERBOSE(F("Interpolation: Initializing"));
 
-  // Convert the step size to Q12.4
-  int16_t _step_size = COORD8_TO_Q12_4(step_size);
-
-  // Get the transition and acc/dec factors
-  ::transition = transition;
-  interp.acc_factor = acc_factor;
-  interp.dec_factor = dec_factor;
+  segment_t segment;
+  interp_segment(transition->start_point, transition->end_point,
+                 settings.step_size, &segment);
 
-  transition->print();
+  return interp_init_segment(transition, segment, settings);
+}
 
-  // Set the initial state
-  interp.state = INTERP_STATE_FIRST;
+void interp_segment(point_q12_4_t start_point, point_q12_4_t end_point,
+                    uint8_t step_size, segment_t *segment) {
 
-  // Set the current step to 0
-  interp.current_step = 0;
+  // Convert the step size to Q12.4
+  int16_t _step_size = COORD8_TO_Q12_4(step_size);
 
   // Get the deltas between the start and end points
-  point_q12_4_t deltas = transition->end_point - transition->start_point;
+  point_q12_4_t deltas = end_point - start_point;
 
   // Get the largest distance of either axis
   uint16_t max_distance = MAX(ABS(deltas.x), ABS(deltas.y));
@@ -48,55 +47,90 @@ bool interp_init(transition_t *transition, uint8_t step_size,
   DEBUG_VERBOSE_VAL("Interpolation: Max distance ", max_distance);
   DEBUG_VERBOSE_VAL("Interpolation: Step size ", step_size);
 
-  if ((int16_t)max_distance < _step_size) {
+  if (_step_size == 0 || (int16_t)max_distance < _step_size) {
 
-    // neither distance is larger than the step size
+    // No interpolation, or neither distance is larger than the step size
 
     DEBUG_VERBOSE(
         F("Interpolation: Neither distance is larger than the step size"));
 
-    interp.total_steps = 1;
-    interp.step = deltas;
-    interp.acc_factor = 0;
-    interp.dec_factor = 0;
-    interp.state = INTERP_STATE_LAST;
+    segment->steps = 0;
+    segment->step = deltas;
 
   } else {
     // Calculate total steps with ceiling division
-    interp.total_steps = (max_distance + _step_size - 1) / _step_size;
+    segment->steps = (max_distance + _step_size - 1) / _step_size;
 
-    if (interp.total_steps > 0) {
-      interp.step.x = deltas.x / interp.total_steps;
-      interp.step.y = deltas.y / interp.total_steps;
+    if (segment->steps > 0) {
+      segment->step.x = deltas.x / segment->steps;
+      segment->step.y = deltas.y / segment->steps;
     } else {
       // This should never happen - caught by the above if statement
       DEBUG_ERROR(F("Interpolation: Total steps is 0"));
-      interp.step = deltas;
+      segment->step = deltas;
     }
   }
+}
+
+bool interp_init_segment(transition_t *transition, const segment_t &segment,
+                         const interp_settings_t &settings) {
+
+  // Get the transition and acc/dec factors
+  ::transition = transition;
+  interp.acc_factor = settings.acc_factor;
+  interp.dec_factor = settings.dec_factor;
+
+  // Set the initial state
+  interp.state = INTERP_STATE_FIRST;
 
-  interp.print();
+  // Set the current step to 0
+  interp.current_step = 0;
+
+  interp.step = segment.step;
+
+  if (segment.steps == 0) {
+    // Short move - straight to the end point
+    interp.total_steps = 1;
+    interp.acc_factor = 0;
+    interp.dec_factor = 0;
+    interp.state = INTERP_STATE_LAST;
+  } else {
+    interp.total_steps = segment.steps;
+  }
+
+  TRACE_EVENT(TRACE_EVT_INTERP_INIT, interp.total_steps,
+              interp.step.x);
 
   return true;
 }
 
-bool interp_next_step() {
+uint16_t interp_segment_length(const segment_t &segment,
+                               const interp_settings_t &settings) {
+  if (segment.steps == 0) {
+    return 1;
+  }
+
+  // Mirrors interp_next_step: acceleration steps, the first full step, the
+  // middle steps, deceleration steps and the final step to the end point
+  uint16_t middle = segment.steps > 2 ? segment.steps - 2 : 0;
+  return settings.acc_factor + 1 + middle + settings.dec_factor + 1;
+}
+
+static bool interp_curve_step();
+static bool interp_arc_step();
 
-  DEBUG_VERBOSE(F("Interpolation: Next step"));
-  interp.print();
+// Called once per output step - keep Serial debug out of here, use
+// TRACE_EVENT() if something needs watching
+bool interp_step() {
 
   switch (interp.state) {
   case INTERP_STATE_READY:
-
-    DEBUG_VERBOSE(F("Interpolation: Ready"));
     interp.state = INTERP_STATE_FIRST;
 
     // No break - fall through to first
 
   case INTERP_STATE_FIRST:
 
-    DEBUG_VERBOSE(F("Interpolation: First"));
-
     // If we're doing first-step acceleration
     if (interp.acc_factor > 0) {
 
@@ -127,8 +161,6 @@ bool interp_next_step() {
     }
   case INTERP_STATE_INTERPOLATE:
 
-    DEBUG_VERBOSE(F("Interpolation: Interpolate"));
-
     if (interp.current_step < interp.total_steps - 1) {
 
       // Regular interpolation - add the step to the current point
@@ -145,8 +177,6 @@ bool interp_next_step() {
     }
   case INTERP_STATE_LAST:
 
-    DEBUG_VERBOSE(F("Interpolation: Last"));
-
     if (interp.dec_factor > 0) {
 
       // Last steps are bitshifted right by 1 for each in dec_factor
@@ -175,8 +205,14 @@ bool interp_next_step() {
       return true;
     }
 
+  case INTERP_STATE_CURVE:
+    return interp_curve_step();
+
+  case INTERP_STATE_ARC:
+    return interp_arc_step();
+
   case INTERP_STATE_FINISHED:
-    DEBUG_ERROR(F("interp_next_step: Unexpected finished state"));
+    DEBUG_ERROR(F("interp_step: Unexpected finished state"));
     return false;
 
   default:
@@ -185,9 +221,325 @@ bool interp_next_step() {
   }
 }
 
+// Bezier curves: the number of steps, as a power of 2 - past CURVE_MAX_SHIFT
+// the extra is subdivision
+static uint8_t interp_curve_shift(point_q12_4_t start_point,
+                                  const curve_t &curve,
+                                  point_q12_4_t end_point, uint8_t step_size) {
+  if (step_size == 0) {
+    return CURVE_MAX_SHIFT;
+  }
+
+  // The control polygon is never shorter than the curve
+  uint16_t length = 0;
+  point_q12_4_t from = start_point;
+  for (uint8_t i = 0; i <= curve.count; i++) {
+    point_q12_4_t to = i < curve.count ? curve.control[i] : end_point;
+    point_q12_4_t delta = to - from;
+    length += MAX(ABS(delta.x), ABS(delta.y));
+    from = to;
+  }
+
+  uint16_t steps = length / COORD8_TO_Q12_4(step_size);
+  uint8_t shift = 0;
+  while (shift < CURVE_MAX_SHIFT + CURVE_MAX_SUB_SHIFT &&
+         (1 << shift) <= steps) {
+    shift++;
+  }
+  return shift;
+}
+
+// Polynomial coefficients of one axis, t = 0..1:
+//   p(t) = a t^3 + b t^2 + c t + p0
+// then the forward differences for steps of t = 1 / 2^shift, scaled by
+// 2^(3 * shift) so they come out as whole numbers
+static void interp_curve_axis(uint8_t axis, int16_t p0, const int16_t *control,
+                              uint8_t count, int16_t p1, uint8_t shift) {
+  int32_t a, b, c;
+  if (count == 2) {
+    a = -(int32_t)p0 + 3L * control[0] - 3L * control[1] + p1;
+    b = 3L * p0 - 6L * control[0] + 3L * control[1];
+    c = 3L * (control[0] - p0);
+  } else {
+    a = 0;
+    b = (int32_t)p0 - 2L * control[0] + p1;
+    c = 2L * (control[0] - p0);
+  }
+
+  interp.curve.pos[axis] = (int32_t)p0 << (3 * shift);
+  interp.curve.d1[axis] = a + b * (1L << shift) + c * (1L << (2 * shift));
+  interp.curve.d2[axis] = 6 * a + 2 * b * (1L << shift);
+  interp.curve.d3[axis] = 6 * a;
+}
+
+// The curve point the forward differences are at - the end point once they
+// have all been added
+static point_q12_4_t interp_curve_point() {
+  if (interp.current_step >= interp.total_steps) {
+    return transition->end_point;
+  }
+  uint8_t shift = 3 * interp.curve.shift;
+  int32_t half = shift ? 1L << (shift - 1) : 0;
+  return point_q12_4_t((interp.curve.pos[0] + half) >> shift,
+                       (interp.curve.pos[1] + half) >> shift);
+}
+
+// Curves and arcs: one even straight step along the chord to the point to,
+// the current_step'th worked out
+static void interp_chord_step(point_q12_4_t to) {
+  interp.sub_step++;
+  uint8_t shift = interp.sub_shift;
+  int16_t remaining = (1 << shift) - interp.sub_step;
+  transition->current_point.x =
+      to.x - (int16_t)(((int32_t)interp.step.x * remaining) >> shift);
+  transition->current_point.y =
+      to.y - (int16_t)(((int32_t)interp.step.y * remaining) >> shift);
+
+  if (remaining == 0) {
+    interp.sub_step = 0;
+    if (interp.current_step >= interp.total_steps) {
+      interp.state = INTERP_STATE_FINISHED;
+    }
+  }
+}
+
+// One output step of a curve - see interp_step
+static bool interp_curve_step() {
+  if (interp.sub_step == 0) {
+    point_q12_4_t from = transition->current_point;
+    interp.current_step++;
+    if (interp.current_step < interp.total_steps) {
+      for (uint8_t axis = 0; axis < 2; axis++) {
+        interp.curve.pos[axis] += interp.curve.d1[axis];
+        interp.curve.d1[axis] += interp.curve.d2[axis];
+        interp.curve.d2[axis] += interp.curve.d3[axis];
+      }
+    }
+    interp.step = interp_curve_point() - from;
+  }
+
+  interp_chord_step(interp_curve_point());
+  return true;
+}
+
+// Arcs: the radius vector carries ARC_FRACTION_BITS extra bits, so rounding
+// in the rotation doesn't build up over the steps
+#define ARC_FRACTION_BITS 16
+
+// Angle an arc turns through from start to end, in CORDIC_TURN units -
+// positive counterclockwise
+static int32_t interp_arc_sweep(point_q12_4_t start_point, const curve_t &curve,
+                                point_q12_4_t end_point) {
+  point_q12_4_t from = start_point - curve.control[0];
+  point_q12_4_t to = end_point - curve.control[0];
+  int32_t dot = (int32_t)from.x * to.x + (int32_t)from.y * to.y;
+  int32_t cross = (int32_t)from.x * to.y - (int32_t)from.y * to.x;
+
+  // Ending in the direction it starts is a full circle
+  int32_t sweep = cross == 0 && dot >= 0 ? 0 : cordic_atan2(cross, dot);
+  if (curve.kind == CURVE_ARC_CCW) {
+    if (sweep <= 0) {
+      sweep += CORDIC_TURN;
+    }
+  } else if (sweep >= 0) {
+    sweep -= CORDIC_TURN;
+  }
+  return sweep;
+}
+
+// Steps for an arc of radius (Q12.4) through sweep - the arc length over the
+// step size, rounded up
+static uint16_t interp_arc_steps(uint16_t radius, int32_t sweep,
+                                 uint8_t step_size) {
+  if (step_size == 0) {
+    return ARC_MAX_POINTS;
+  }
+
+  // Radius times the fraction of a turn, then times 2 pi (201 / 32)
+  uint32_t turned = ((uint32_t)(ABS(sweep) >> 14) * radius) >> 16;
+  uint32_t length = (turned * 201) >> 5;
+
+  uint16_t step = COORD8_TO_Q12_4(step_size);
+  uint32_t steps = (length + step - 1) / step;
+  return constrain(steps, 1, (uint16_t)ARC_MAX_POINTS << ARC_MAX_SUB_SHIFT);
+}
+
+// Past ARC_MAX_POINTS an arc is subdivided - each point worked out is
+// reached in 1 << the returned shift straight steps
+static uint8_t interp_arc_sub_shift(uint16_t steps) {
+  uint8_t shift = 0;
+  while (steps > ((uint16_t)ARC_MAX_POINTS << shift)) {
+    shift++;
+  }
+  return shift;
+}
+
+// Points an arc of steps works out - all ARC_MAX_POINTS once it is
+// subdivided, so the chords stay short
+static inline uint8_t interp_arc_points(uint16_t steps, uint8_t sub_shift) {
+  return sub_shift ? ARC_MAX_POINTS : steps;
+}
+
+uint16_t interp_curve_length(point_q12_4_t start_point, const curve_t &curve,
+                             point_q12_4_t end_point, uint8_t step_size) {
+  if (!curve.is_arc()) {
+    return 1 << interp_curve_shift(start_point, curve, end_point, step_size);
+  }
+
+  point_q12_4_t radius = start_point - curve.control[0];
+  uint16_t steps = interp_arc_steps(
+      cordic_hypot(radius.x, radius.y),
+      interp_arc_sweep(start_point, curve, end_point), step_size);
+  uint8_t sub_shift = interp_arc_sub_shift(steps);
+  return (uint16_t)interp_arc_points(steps, sub_shift) << sub_shift;
+}
+
+// value * factor for a Q1.15 factor, from two 16 x 16 -> 32 bit multiplies
+// of the value's high and low halves - AVR has no wider multiply
+static inline int32_t interp_arc_mul(int32_t value, int16_t factor) {
+  int16_t high = value >> 16;
+  uint16_t low = value;
+  return (int32_t)high * factor * 2 + (((int32_t)low * factor) >> 15);
+}
+
+// The arc point the radius vector is at - the end point once it has turned
+// all the way
+static point_q12_4_t interp_arc_point() {
+  if (interp.current_step >= interp.total_steps) {
+    return transition->end_point;
+  }
+
+  // An arc can bulge past the edge of the DAC range
+  int32_t half = 1L << (ARC_FRACTION_BITS - 1);
+  int32_t x =
+      interp.arc.centre[0] + ((interp.arc.radius[0] + half) >> ARC_FRACTION_BITS);
+  int32_t y =
+      interp.arc.centre[1] + ((interp.arc.radius[1] + half) >> ARC_FRACTION_BITS);
+  return point_q12_4_t(constrain(x, 0, ARC_MAX_OUTPUT),
+                       constrain(y, 0, ARC_MAX_OUTPUT));
+}
+
+// One output step of an arc - turns the radius vector by the
+// per-step rotation, eight 16 x 16 -> 32 bit multiplies, at each point
+static bool interp_arc_step() {
+  if (interp.sub_step == 0) {
+    point_q12_4_t from = transition->current_point;
+    interp.current_step++;
+    if (interp.current_step < interp.total_steps) {
+      int32_t x = interp.arc.radius[0];
+      int32_t y = interp.arc.radius[1];
+      interp.arc.radius[0] = interp_arc_mul(x, interp.arc.cosine) -
+                             interp_arc_mul(y, interp.arc.sine);
+      interp.arc.radius[1] = interp_arc_mul(x, interp.arc.sine) +
+                             interp_arc_mul(y, interp.arc.cosine);
+    }
+    interp.step = interp_arc_point() - from;
+  }
+
+  interp_chord_step(interp_arc_point());
+  return true;
+}
+
+// Q1.30 to Q1.15, rounded
+static int16_t interp_arc_factor(int32_t value) {
+  int32_t factor = (value + (1L << (CORDIC_SHIFT - 16))) >> (CORDIC_SHIFT - 15);
+  return factor > INT16_MAX ? INT16_MAX : factor;
+}
+
+static bool interp_init_arc(transition_t *transition, const curve_t &curve,
+                            uint8_t step_size) {
+  ::transition = transition;
+
+  point_q12_4_t centre = curve.control[0];
+  point_q12_4_t radius = transition->start_point - centre;
+  int32_t sweep =
+      interp_arc_sweep(transition->start_point, curve, transition->end_point);
+  uint16_t steps =
+      interp_arc_steps(cordic_hypot(radius.x, radius.y), sweep, step_size);
+  uint8_t sub_shift = interp_arc_sub_shift(steps);
+  uint8_t points = interp_arc_points(steps, sub_shift);
+
+  // The one trig call of the arc, rounded to Q1.15 - 1.0 itself doesn't fit
+  int32_t cosine, sine;
+  cordic_sincos(sweep / (int32_t)points, &cosine, &sine);
+  interp.arc.cosine = interp_arc_factor(cosine);
+  interp.arc.sine = interp_arc_factor(sine);
+
+  interp.arc.radius[0] = (int32_t)radius.x << ARC_FRACTION_BITS;
+  interp.arc.radius[1] = (int32_t)radius.y << ARC_FRACTION_BITS;
+  interp.arc.centre[0] = centre.x;
+  interp.arc.centre[1] = centre.y;
+
+  interp.sub_shift = sub_shift;
+  interp.sub_step = 0;
+  interp.current_step = 0;
+  interp.total_steps = points;
+  interp.state = INTERP_STATE_ARC;
+
+  TRACE_EVENT(TRACE_EVT_INTERP_INIT, interp.total_steps, 0);
+
+  return true;
+}
+
+bool interp_init_curve(transition_t *transition, const curve_t &curve,
+                       uint8_t step_size) {
+  if (curve.is_arc()) {
+    return interp_init_arc(transition, curve, step_size);
+  }
+
+  ::transition = transition;
+
+  uint8_t shift = interp_curve_shift(transition->start_point, curve,
+                                     transition->end_point, step_size);
+  uint8_t sub_shift = shift > CURVE_MAX_SHIFT ? shift - CURVE_MAX_SHIFT : 0;
+  shift -= sub_shift;
+  int16_t control_x[CURVE_MAX_CONTROLS], control_y[CURVE_MAX_CONTROLS];
+  for (uint8_t i = 0; i < curve.count; i++) {
+    control_x[i] = curve.control[i].x;
+    control_y[i] = curve.control[i].y;
+  }
+  interp_curve_axis(0, transition->start_point.x, control_x, curve.count,
+                    transition->end_point.x, shift);
+  interp_curve_axis(1, transition->start_point.y, control_y, curve.count,
+                    transition->end_point.y, shift);
+
+  interp.curve.shift = shift;
+  interp.sub_shift = sub_shift;
+  interp.sub_step = 0;
+  interp.current_step = 0;
+  interp.total_steps = 1 << shift;
+  interp.state = INTERP_STATE_CURVE;
+
+  TRACE_EVENT(TRACE_EVT_INTERP_INIT, interp.total_steps, 0);
+
+  return true;
+}
+
+interp_settings_t interp_settings[INTERP_PROFILE_COUNT] = {
+    {DEFAULT_STEP_SIZE, DEFAULT_ACC_FACTOR, DEFAULT_DEC_FACTOR},
+    {DEFAULT_BLANK_STEP_SIZE, DEFAULT_BLANK_ACC_FACTOR,
+     DEFAULT_BLANK_DEC_FACTOR},
+};
+
+static void interp_set_profile(interp_settings_t *settings, uint8_t step_size,
+                               uint8_t acc_factor, uint8_t dec_factor) {
+  settings->step_size = step_size;
+  settings->acc_factor = acc_factor;
+  settings->dec_factor = dec_factor;
+}
+
+void interp_configure() {
+  interp_set_profile(&interp_settings[INTERP_PROFILE_LIT],
+                     g_config.renderer.max_step_size,
+                     g_config.renderer.acc_factor,
+                     g_config.renderer.dec_factor);
+  interp_set_profile(&interp_settings[INTERP_PROFILE_BLANK],
+                     g_config.renderer.blank_step_size,
+                     g_config.renderer.blank_acc_factor,
+                     g_config.renderer.blank_dec_factor);
+}
+
 bool interp_active() {
-  DEBUG_VERBOSE_VAL("Interpolation active: ",
-                    interp.state != INTERP_STATE_FINISHED);
   return interp.state != INTERP_STATE_FINISHED;
 }
 
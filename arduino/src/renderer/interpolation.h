@@ -2,13 +2,18 @@
 
 #include "../config.h"
 #include "../debug.h"
+#include "../diagnostics/profiler.h"
+#include "../diagnostics/trace.h"
 #include "../types.h"
+#include "curve.h"
 
 enum interp_state_t {
   INTERP_STATE_READY,
   INTERP_STATE_FIRST,
   INTERP_STATE_INTERPOLATE,
   INTERP_STATE_LAST,
+  INTERP_STATE_CURVE, // Bezier curve, see curve.h
+  INTERP_STATE_ARC,   // Circular arc, see curve.h
   INTERP_STATE_FINISHED
 };
 
@@ -24,6 +29,30 @@ struct interpolation_t {
 
   interp_state_t state;
 
+  // Curves and arcs: each point worked out is reached in 1 << sub_shift
+  // even straight steps, step holding the chord to it
+  uint8_t sub_shift;
+  uint8_t sub_step;
+
+  // Curves and arcs (see curve.h) - a move is only ever one of them
+  union {
+    struct {
+      // Position and forward differences per axis, in Q12.4 units of
+      // 1 / 2^(3 * shift)
+      int32_t pos[2];
+      int32_t d1[2];
+      int32_t d2[2];
+      int32_t d3[2];
+      uint8_t shift; // 1 << shift points worked out
+    } curve;
+    struct {
+      int32_t radius[2]; // From the centre, Q12.4 << ARC_FRACTION_BITS
+      int16_t cosine;    // Rotation per step, Q1.15
+      int16_t sine;
+      int16_t centre[2];
+    } arc;
+  };
+
   inline void print() const {
     DEBUG_INFO_VAL2("Interpolation: Step ", step.x, step.y);
     DEBUG_INFO_VAL("Interpolation: Current step ", current_step);
@@ -36,12 +65,69 @@ struct interpolation_t {
 extern interpolation_t interp;
 extern transition_t *transition;
 
-bool interp_init(transition_t *transition,
-                 uint8_t step_size = g_config.renderer.max_step_size,
-                 uint8_t acc_factor = g_config.renderer.acc_factor,
-                 uint8_t dec_factor = g_config.renderer.dec_factor);
+// Speed profiles - blanked moves (laser off at both ends) have their own
+enum interp_profile_t : uint8_t {
+  INTERP_PROFILE_LIT,
+  INTERP_PROFILE_BLANK,
+  INTERP_PROFILE_COUNT
+};
+
+// Snapshot of the renderer config taken by interp_configure - a move and the
+// frame's segment table always use the same step size and acc/dec factors
+struct interp_settings_t {
+  uint8_t step_size;
+  uint8_t acc_factor;
+  uint8_t dec_factor;
+};
+
+extern interp_settings_t interp_settings[INTERP_PROFILE_COUNT];
+
+// Take a new snapshot of g_config.renderer. Call whenever the renderer config
+// changes.
+void interp_configure();
 
-bool interp_next_step();
+bool interp_init(
+    transition_t *transition,
+    const interp_settings_t &settings = interp_settings[INTERP_PROFILE_LIT]);
+
+// Start a transition from a segment worked out earlier by interp_segment -
+// skips the divisions in interp_init
+bool interp_init_segment(
+    transition_t *transition, const segment_t &segment,
+    const interp_settings_t &settings = interp_settings[INTERP_PROFILE_LIT]);
+
+// Step count and per-step increment for a move between two points
+void interp_segment(point_q12_4_t start_point, point_q12_4_t end_point,
+                    uint8_t step_size, segment_t *segment);
+
+// Number of steps interp_next_step outputs for a segment
+uint16_t interp_segment_length(const segment_t &segment,
+                               const interp_settings_t &settings);
+
+// Curves and arcs (see curve.h): the number of steps one takes
+uint16_t interp_curve_length(point_q12_4_t start_point, const curve_t &curve,
+                             point_q12_4_t end_point, uint8_t step_size);
+
+// Start a curve or arc transition - control points from curve, step count
+// from the lit step size. Curves have no acceleration or deceleration.
+bool interp_init_curve(transition_t *transition, const curve_t &curve,
+                       uint8_t step_size);
+
+// Every step but the middle ones of a straight move - see interp_next_step
+bool interp_step();
+
+// Called once per output step. The middle of a straight move, nearly every
+// step drawn, is done here inline - acceleration, deceleration, curves and
+// arcs are left to interp_step.
+inline bool interp_next_step() {
+  if (interp.state == INTERP_STATE_INTERPOLATE &&
+      interp.current_step < interp.total_steps - 1) {
+    transition->current_point += interp.step;
+    interp.current_step++;
+    return true;
+  }
+  return interp_step();
+}
 
 bool interp_active();
 
@@ -0,0 +1,170 @@
+#include "program.h"
+#include <avr/pgmspace.h>
+
+// Instruction length in bytes, opcode included
+static const uint8_t op_size[PROGRAM_OP_COUNT] PROGMEM = {
+    1, // END
+    3, // MOVE
+    3, // LINE
+    3, // MOVE_REL
+    3, // LINE_REL
+    4, // POINT
+    2, // BLANK
+    2, // REPEAT
+    1, // NEXT
+    3, // CALL
+    1, // RET
+    1, // PUSH
+    1, // POP
+    3, // TRANSLATE
+};
+
+static inline bool program_push(program_state_t *state, uint8_t kind,
+                                uint8_t count, uint16_t value) {
+  if (state->sp >= PROGRAM_STACK_DEPTH) {
+    return false;
+  }
+  state->stack[state->sp++] = {kind, count, value};
+  return true;
+}
+
+// Top of the stack if it was pushed by kind, otherwise nullptr
+static inline program_frame_t *program_top(program_state_t *state,
+                                           uint8_t kind) {
+  if (state->sp == 0 || state->stack[state->sp - 1].kind != kind) {
+    return nullptr;
+  }
+  return &state->stack[state->sp - 1];
+}
+
+static inline program_result_t program_output(program_state_t *state,
+                                              uint8_t x, uint8_t y,
+                                              uint8_t flags,
+                                              point_coord8_t *point) {
+  state->x = x;
+  state->y = y;
+  state->points++;
+  *point = point_coord8_t(x + state->offset_x, y + state->offset_y,
+                          flags & ~LAST_POINT_BIT);
+  return PROGRAM_POINT;
+}
+
+program_result_t program_next_point(const uint8_t *code, uint16_t length,
+                                    program_state_t *state,
+                                    point_coord8_t *point) {
+  if (state->points >= PROGRAM_MAX_POINTS) {
+    return PROGRAM_END;
+  }
+
+  for (uint16_t ops = 0; ops < PROGRAM_MAX_IDLE_OPS; ops++) {
+    if (state->pc >= length) {
+      return PROGRAM_END;
+    }
+    if (++state->ops > PROGRAM_MAX_OPS) {
+      return PROGRAM_FAULT;
+    }
+
+    uint8_t op = code[state->pc];
+    if (op >= PROGRAM_OP_COUNT) {
+      return PROGRAM_FAULT;
+    }
+    uint8_t size = pgm_read_byte(&op_size[op]);
+    if (state->pc + size > length) {
+      return PROGRAM_FAULT;
+    }
+    const uint8_t *arg = code + state->pc + 1;
+    state->pc += size;
+
+    program_frame_t *top;
+    switch (op) {
+    case PROGRAM_OP_END:
+      return PROGRAM_END;
+
+    case PROGRAM_OP_MOVE:
+      return program_output(state, arg[0], arg[1], BLANKING_BIT, point);
+
+    case PROGRAM_OP_LINE:
+      return program_output(state, arg[0], arg[1],
+                            state->blank ? BLANKING_BIT : 0, point);
+
+    case PROGRAM_OP_MOVE_REL:
+      return program_output(state, state->x + (int8_t)arg[0],
+                            state->y + (int8_t)arg[1], BLANKING_BIT, point);
+
+    case PROGRAM_OP_LINE_REL:
+      return program_output(state, state->x + (int8_t)arg[0],
+                            state->y + (int8_t)arg[1],
+                            state->blank ? BLANKING_BIT : 0, point);
+
+    case PROGRAM_OP_POINT:
+      return program_output(state, arg[0], arg[1], arg[2], point);
+
+    case PROGRAM_OP_BLANK:
+      state->blank = arg[0];
+      break;
+
+    case PROGRAM_OP_REPEAT:
+      if (arg[0] == 0 ||
+          !program_push(state, PROGRAM_OP_REPEAT, arg[0], state->pc)) {
+        return PROGRAM_FAULT;
+      }
+      break;
+
+    case PROGRAM_OP_NEXT:
+      top = program_top(state, PROGRAM_OP_REPEAT);
+      if (!top) {
+        return PROGRAM_FAULT;
+      }
+      if (--top->count) {
+        state->pc = top->value;
+      } else {
+        state->sp--;
+      }
+      break;
+
+    case PROGRAM_OP_CALL:
+      if (!program_push(state, PROGRAM_OP_CALL, 0, state->pc)) {
+        return PROGRAM_FAULT;
+      }
+      state->pc = arg[0] | (uint16_t)arg[1] << 8;
+      if (state->pc >= length) {
+        return PROGRAM_FAULT;
+      }
+      break;
+
+    case PROGRAM_OP_RET:
+      top = program_top(state, PROGRAM_OP_CALL);
+      if (!top) {
+        return PROGRAM_FAULT;
+      }
+      state->pc = top->value;
+      state->sp--;
+      break;
+
+    case PROGRAM_OP_PUSH:
+      if (!program_push(state, PROGRAM_OP_PUSH, 0,
+                        state->offset_x | (uint16_t)state->offset_y << 8)) {
+        return PROGRAM_FAULT;
+      }
+      break;
+
+    case PROGRAM_OP_POP:
+      top = program_top(state, PROGRAM_OP_PUSH);
+      if (!top) {
+        return PROGRAM_FAULT;
+      }
+      state->offset_x = top->value;
+      state->offset_y = top->value >> 8;
+      state->sp--;
+      break;
+
+    case PROGRAM_OP_TRANSLATE:
+      state->offset_x += arg[0];
+      state->offset_y += arg[1];
+      break;
+    }
+  }
+
+  // Looping without output
+  return PROGRAM_FAULT;
+}
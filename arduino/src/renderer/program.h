@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../debug.h"
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * DISPLAY LIST PROGRAMS
+ * ============================================================================
+ *
+ * FRAME_FORMAT_PROGRAM frames hold bytecode instead of points. The renderer
+ * reads them through point_arena_t::next_point like any other frame - the
+ * interpreter runs until the program outputs its next point, so one pass is
+ * worked out a segment at a time and never expanded in RAM.
+ *
+ *   00                END         end of the pass (so is the end of the data)
+ *   01 x y            MOVE        blanked point
+ *   02 x y            LINE        lit point, blanked after BLANK 1
+ *   03 dx dy          MOVE_REL    MOVE relative to the last point
+ *   04 dx dy          LINE_REL    LINE relative to the last point
+ *   05 x y flags      POINT       point with raw flags - curves and arcs
+ *   06 on             BLANK       LINE/LINE_REL draw blanked while on
+ *   07 n              REPEAT      run up to the matching NEXT n times, n > 0
+ *   08                NEXT
+ *   09 lo hi          CALL        run the subroutine at byte lo | hi << 8
+ *   0A                RET
+ *   0B                PUSH        save the offset
+ *   0C                POP         restore the offset
+ *   0D dx dy          TRANSLATE   add to the offset
+ *
+ * Coordinates are coord8, deltas are signed. The offset is added to every
+ * point output and wraps modulo 256, like delta records. REPEAT, CALL and
+ * PUSH share a PROGRAM_STACK_DEPTH deep stack - NEXT, RET and POP must match
+ * the top entry.
+ *
+ * A pass stops after PROGRAM_MAX_POINTS points, and a program that runs
+ * PROGRAM_MAX_IDLE_OPS instructions without a point, or PROGRAM_MAX_OPS in
+ * one pass, is faulty. Programs are run through once when committed, so a
+ * faulty one never gets displayed - the limits keep that run short.
+ *
+ * ============================================================================
+ */
+
+#define PROGRAM_STACK_DEPTH 4
+#define PROGRAM_MAX_POINTS 1024
+#define PROGRAM_MAX_IDLE_OPS 1024
+#define PROGRAM_MAX_OPS 8192
+
+enum program_op_t : uint8_t {
+  PROGRAM_OP_END,
+  PROGRAM_OP_MOVE,
+  PROGRAM_OP_LINE,
+  PROGRAM_OP_MOVE_REL,
+  PROGRAM_OP_LINE_REL,
+  PROGRAM_OP_POINT,
+  PROGRAM_OP_BLANK,
+  PROGRAM_OP_REPEAT,
+  PROGRAM_OP_NEXT,
+  PROGRAM_OP_CALL,
+  PROGRAM_OP_RET,
+  PROGRAM_OP_PUSH,
+  PROGRAM_OP_POP,
+  PROGRAM_OP_TRANSLATE,
+  PROGRAM_OP_COUNT
+};
+
+enum program_result_t : uint8_t {
+  PROGRAM_POINT, // point is the next point
+  PROGRAM_END,   // End of the pass
+  PROGRAM_FAULT, // Bad instruction, stack misuse or runaway loop
+};
+
+struct program_frame_t {
+  uint8_t kind;   // PROGRAM_OP_REPEAT, PROGRAM_OP_CALL or PROGRAM_OP_PUSH
+  uint8_t count;  // REPEAT: passes left
+  uint16_t value; // REPEAT: loop start, CALL: return address, PUSH: offset
+};
+
+// Interpreter state - part of frame_cursor_t
+struct program_state_t {
+  uint16_t pc;
+  uint16_t points;    // Output this pass
+  uint16_t ops;       // Run this pass
+  uint8_t x, y;       // Last point, before the offset
+  uint8_t offset_x, offset_y;
+  uint8_t sp;
+  bool blank;
+  program_frame_t stack[PROGRAM_STACK_DEPTH];
+
+  inline void reset() {
+    pc = 0;
+    points = 0;
+    ops = 0;
+    x = y = 0;
+    offset_x = offset_y = 0;
+    sp = 0;
+    blank = false;
+  }
+};
+
+// Run the program in code (length bytes) up to its next point
+program_result_t program_next_point(const uint8_t *code, uint16_t length,
+                                    program_state_t *state,
+                                    point_coord8_t *point);
@@ -19,17 +19,37 @@ void Renderer::init() {
   DEBUG_VERBOSE(F("Renderer::init"));
 
   step_buf.clear();
+  update_laser_delay();
+#if ENABLE_EMPHASIS
+  emphasis.clear();
+#endif
+  update_emphasis();
+  transform.build(g_config.renderer);
+  transform_changed = false;
+  update_grid();
   interp_clear();
-  point_buf_a.clear();
-  point_buf_b.clear();
-  active_point_buf = &point_buf_a;
-  inactive_point_buf = &point_buf_b;
-  point_buf_index = 0;
-  swap_requested = false;
+  interp_configure();
+  point_arena.clear();
+  frame_cursor.reset();
+  step_cache.invalidate();
 
   transition = transition_t();
+  transition_exact = false;
+  transition_shape = MOVE_LINE;
+  transition_clamped = false;
+  curve.clear();
+  clipper.reset(transition.current_point);
+  move_pending = false;
+  pass_moved = false;
+#if ENABLE_PROFILER
+  pass_start = clock_ticks();
+#endif
   stats = render_stats_t();
+#if ENABLE_FRAME_SUMMARY
+  summary_state = SUMMARY_DONE;
+#endif
   dwell = 0;
+  last_move.clear();
 
   render_state = IDLE_EMPTY;
 
@@ -38,44 +58,292 @@ void Renderer::init() {
   // dummy data for the buffer
   point_coord8_t dummy_points[] = {
       {0, 0, 0}, {200, 0, 255}, {200, 200, 0}, {0, 200, 0}};
+  begin_frame(4);
   for (int i = 0; i < 4; i++) {
-    inactive_point_buf->set_point(i, dummy_points[i]);
+    set_frame_point(i, dummy_points[i]);
   }
-  inactive_point_buf->set_point_count(4);
+  commit_frame();
   DEBUG_VERBOSE(F("Renderer::init: Dummy data set"));
 }
 
 bool Renderer::swap_buffers() {
+  PROFILE_ZONE(PROFILE_BUFFER_SWAP);
   DEBUG_VERBOSE(F("Renderer::swap_buffers"));
 
-  noInterrupts();
+  // Make the committed frame the displayed one
+  if (!point_arena.swap()) {
+    return false;
+  }
 
-  // Swap the active and inactive point buffers
-  coord8_point_buf_t *tmp = active_point_buf;
-  active_point_buf = inactive_point_buf;
-  inactive_point_buf = tmp;
+  step_cache.invalidate();
 
-  interrupts();
+  // Control points left at the end of the old frame don't carry over
+  curve.clear();
 
+  TRACE_EVENT(TRACE_EVT_BUFFER_SWAP, point_arena.front.point_count, 0);
   DEBUG_VERBOSE(F("Renderer::swap_buffers: Buffers swapped"));
 
   return true;
 }
 
-void Renderer::process() {
+bool Renderer::begin_frame(uint8_t point_count, uint8_t format) {
+  DEBUG_VERBOSE(F("Renderer::begin_frame"));
+
+#if ENABLE_FRAME_SUMMARY
+  // A committed frame taken back before it was drawn is never summed up
+  if (point_arena.back_ready) {
+    summary_state = SUMMARY_DONE;
+  }
+#endif
+  return point_arena.begin(point_count, format);
+}
+
+bool Renderer::set_frame_point(uint8_t index, point_coord8_t point) {
+  if (point_arena.back_ready) {
+    return false;
+  }
+  return point_arena.set_point(index, point);
+}
+
+bool Renderer::append_frame_byte(uint8_t byte) {
+  if (point_arena.back_ready) {
+    return false;
+  }
+  return point_arena.append_byte(byte);
+}
+
+bool Renderer::commit_frame() {
+  DEBUG_VERBOSE(F("Renderer::commit_frame"));
+
+  if (!point_arena.back_complete()) {
+    return false;
+  }
+
+  // A generated frame can run to thousands of points, too many to go through
+  // while the step ring drains - it is only checked here, and summed up as
+  // its first repeat pass is drawn
+  if (FRAME_FORMAT_IS_GENERATED(point_arena.back.format)) {
+    if (!point_arena.finish_generated()) {
+      return false;
+    }
+#if ENABLE_FRAME_SUMMARY
+    summary = frame_summary_t();
+    summary_state = SUMMARY_WAIT;
+#endif
+  } else {
+    compile_frame();
+#if ENABLE_FRAME_SUMMARY
+    summary_state = SUMMARY_DONE;
+#endif
+  }
+  return point_arena.commit();
+}
+
+#if ENABLE_FRAME_SUMMARY
+// Timer ticks to microseconds without overflowing 32 bits
+static uint32_t steps_to_us(uint32_t steps, uint32_t frequency) {
+  if (frequency == 0) {
+    return 0;
+  }
+  uint32_t whole = 1000000UL / frequency;
+  uint32_t rem = 1000000UL % frequency;
+  return steps * whole + (steps / frequency) * rem +
+         ((steps % frequency) * rem) / frequency;
+}
+#endif
+
+// Blanked moves - laser off at both ends - use the blank speed profile
+static inline const interp_settings_t &transition_settings(bool start_laser,
+                                                           bool end_laser) {
+  return interp_settings[start_laser || end_laser ? INTERP_PROFILE_LIT
+                                                  : INTERP_PROFILE_BLANK];
+}
+
+// A frame point as it will be drawn - after the transform
+struct drawn_point_t {
+  point_q12_4_t position;
+  bool laser;
+
+  drawn_point_t() : position(0, 0), laser(false) {}
+  drawn_point_t(const transform_t &transform, point_coord8_t point)
+      : position(transform.apply(point)), laser(IS_LASER_ON(point.flags)) {}
+  drawn_point_t(const zone_move_t &move)
+      : position(move.point), laser(move.laser) {}
+};
+
+// Works out the segment from one frame point to the next with the profile
+// and dwell the renderer will draw it with, and adds it to the summary. move
+// is the move that arrived at from, and is advanced to this one.
+static void compile_segment(frame_summary_t *summary, dwell_move_t *move,
+                            const drawn_point_t &from, const drawn_point_t &to,
+                            const curve_t &curve, segment_t *segment) {
+  const interp_settings_t &settings = transition_settings(from.laser, to.laser);
+
+  uint32_t steps;
+  if (curve.count) {
+    steps = interp_curve_length(from.position, curve, to.position,
+                                settings.step_size);
+  } else {
+    interp_segment(from.position, to.position, settings.step_size, segment);
+    steps = interp_segment_length(*segment, settings);
+  }
+  steps += transition_dwell(*move, curve.entry(from.position, to.position),
+                            from.laser, to.laser);
+
+  summary->total_steps += steps;
+  if (!to.laser) {
+    summary->blank_steps += steps;
+  }
+
+  move->update(curve.exit(from.position, to.position),
+               !from.laser && !to.laser);
+}
+
+// State carried from one segment of a pass to the next
+struct frame_pass_t {
+  zone_clipper_t clipper;
+  curve_t curve;    // Control points read so far
+  drawn_point_t at; // Where the last move drawn ended
+  dwell_move_t move;
+};
+
+// Goes through one pass of the frame the way the renderer draws it - through
+// the safety zone, with curves - starting from the segment back to the first
+// point. With a summary, adds every move to it and fills in the segment table
+// if table is set.
+void Renderer::compile_pass(const frame_region_t &frame, const transform_t &xf,
+                            const zone_t &zone, frame_pass_t *pass,
+                            frame_summary_t *summary, bool table) {
+  curve_t straight;
+  straight.clear();
+
+  frame_cursor_t cursor;
+  cursor.reset();
+
+  point_coord8_t point;
+  drawn_point_t prev(xf, point_coord8_t());
+  segment_t segment;
+
+  while (point_arena.next_point(frame, &cursor, &point)) {
+    drawn_point_t next(xf, point);
+    if (IS_CURVE_CONTROL(point.flags)) {
+      pass->curve.add(next.position, point.flags, xf.mirrored);
+      continue;
+    }
+
+    zone_move_t moves[2];
+    bool exact;
+    uint8_t count = pass->clipper.next(zone, next.position, next.laser,
+                                       pass->curve, moves, &exact);
+
+    for (uint8_t i = 0; i < count; i++) {
+      drawn_point_t to(moves[i]);
+      const curve_t &curve =
+          moves[i].shape == MOVE_LINE ? straight : pass->curve;
+      if (summary) {
+        compile_segment(summary, &pass->move, pass->at, to, curve, &segment);
+      } else {
+        pass->move.update(curve.exit(pass->at.position, to.position),
+                          !pass->at.laser && !to.laser);
+      }
+      pass->at = to;
+    }
+
+    // The table holds the frame's own straight segments - blanked curves are
+    // straight too. The renderer only uses an entry for a segment the zone
+    // leaves alone.
+    if (table && cursor.index > 1 && !(next.laser && pass->curve.count)) {
+      if (!exact) {
+        interp_segment(prev.position, next.position,
+                       transition_settings(prev.laser, next.laser).step_size,
+                       &segment);
+      }
+      point_arena.set_segment(cursor.index - 1, segment);
+    }
+
+    pass->curve.clear();
+    prev = next;
+  }
+}
+
+// Runs once per committed frame: works out every segment of the back frame,
+// stores them for playback if the arena has room, and fills in the summary
+void Renderer::compile_frame() {
+  PROFILE_ZONE(PROFILE_FRAME_COMPILE);
+
+#if !ENABLE_FRAME_SUMMARY
+  // Still worked out - the segment table is filled in along with it
+  frame_summary_t summary;
+#endif
+  summary = frame_summary_t();
+
+  // The frame is drawn with the transform in place at the next frame
+  // boundary - a pending one if there is one
+  transform_t xf = transform;
+  if (transform_pending()) {
+    xf.build(g_config.renderer);
+  }
+
+  zone_t zone;
+  zone.build(g_config.renderer);
+
+  bool table = point_arena.reserve_table(
+      interp_settings[INTERP_PROFILE_LIT].step_size,
+      interp_settings[INTERP_PROFILE_BLANK].step_size);
+  const frame_region_t &frame = point_arena.back;
 
-  swap_requested = true;
-  transition.print();
+  point_coord8_t point;
+  frame_cursor_t cursor;
+  cursor.reset();
+  if (!point_arena.next_point(frame, &cursor, &point)) {
+    return;
+  }
+
+  // Dwell, clipping and the curve back to the first point depend on what
+  // came before, so start from where a pass leaves them when the frame
+  // repeats
+  frame_pass_t pass;
+  pass.at = drawn_point_t(xf, point);
+  pass.clipper.reset(pass.at.position);
+  pass.curve.clear();
+  pass.move.clear();
+  compile_pass(frame, xf, zone, &pass, nullptr, false);
+
+  compile_pass(frame, xf, zone, &pass, &summary, table);
+
+#if ENABLE_FRAME_SUMMARY
+  summary.frame_us = steps_to_us(summary.total_steps, g_config.timer.frequency);
+#endif
+}
+
+// Rebuilds the transform from g_config.renderer at the next frame boundary.
+// Segment tables already worked out were for the old transform.
+void Renderer::update_transform() {
+  transform_changed = true;
+  point_arena.front.table_stale = true;
+  point_arena.back.table_stale = true;
+}
+
+// Cached steps were corrected with the old grid
+void Renderer::update_grid() {
+#if ENABLE_GRID
+  grid_active = g_config.renderer.grid_correction && grid_is_loaded();
+  step_cache.invalidate();
+#endif
+}
+
+void Renderer::process() {
+  PROFILE_ZONE(PROFILE_RENDER_PROCESS);
 
   switch (render_state) {
   case IDLE_EMPTY:
 
-    if (active_point_buf->is_empty() && inactive_point_buf->is_empty()) {
+    if (point_arena.front.is_empty() && !point_arena.back_ready) {
       stats.point_buf_wait++;
       return;
     }
 
-    if (active_point_buf->is_empty()) {
+    if (point_arena.front.is_empty()) {
       render_state = IDLE_BUFFER_SWAP;
     } else {
       render_state = IDLE_READY;
@@ -84,7 +352,8 @@ void Renderer::process() {
 
   case IDLE_READY:
 
-    point_buf_index = 0;
+    frame_cursor.reset();
+    pass_moved = false;
 
     // This loads the first point - the "end" of the transition is point 0 and
     // the "start" is undefined. Hence we do not init interp.
@@ -97,7 +366,7 @@ void Renderer::process() {
     break;
 
   case IDLE_BUFFER_SWAP:
-    if (!swap_requested) {
+    if (!point_arena.back_ready) {
       stats.point_buf_wait++;
       return;
     }
@@ -110,7 +379,7 @@ void Renderer::process() {
 
     stats.point_buf_wait = 0;
 
-    if (active_point_buf->is_empty()) {
+    if (point_arena.front.is_empty()) {
       render_state = ERROR_BUFFER_FAULT;
       return;
     }
@@ -122,13 +391,22 @@ void Renderer::process() {
   case RENDER_GET_POINT:
 
     if (!get_next_transition(&transition)) {
+      // Every segment was clipped away. The ISR holds the last step, so
+      // park the beam blanked where it is rather than leave it lit there.
+      if (!pass_moved) {
+        transition.set_next(transition.current_point, false);
+        park_step();
+      }
+      pass_moved = false;
       render_state = RENDER_BUFFER_END;
       return;
     }
+    pass_moved = true;
 
-    interp_init(&transition);
+    start_interp();
 
     if (get_dwell()) {
+      TRACE_EVENT(TRACE_EVT_DWELL, dwell, 0);
       render_state = RENDER_DWELL;
     } else {
       render_state = RENDER_INTERPOLATE;
@@ -144,7 +422,7 @@ void Renderer::process() {
       stats.step_buf_wait = 0;
     }
 
-    step_buf.push(transition.current_point, transition.get_current_laser());
+    push_step(step_point(), step_laser());
     dwell--;
 
     if (dwell == 0) {
@@ -167,7 +445,7 @@ void Renderer::process() {
       return;
     }
 
-    step_buf.push(transition.current_point, transition.get_current_laser());
+    push_step(step_point(), step_laser());
 
     if (!interp_active()) {
       render_state = RENDER_GET_POINT;
@@ -177,21 +455,47 @@ void Renderer::process() {
 
   case RENDER_BUFFER_END:
 
-    point_buf_index = 0;
-    if (swap_requested) {
+    TRACE_EVENT(TRACE_EVT_BUFFER_END, point_arena.front.point_count,
+                stats.point_buf_repeat);
+
+    frame_cursor.reset();
+    profile_pass();
+    step_cache.finish_recording();
+    count_summary_pass();
+
+    if (transform_pending()) {
+      transform.build(g_config.renderer);
+      transform_changed = false;
+      step_cache.invalidate();
+    }
+
+    if (point_arena.back_ready) {
       render_state = RENDER_BUFFER_SWAP;
-    } else {
-      stats.point_buf_repeat++;
-      render_state = RENDER_GET_POINT;
+      break;
+    }
+
+    stats.point_buf_repeat++;
+    render_state = RENDER_GET_POINT;
+
+    // Every repeat pass outputs the same steps - replay the recorded pass if
+    // there is one, otherwise record this one
+    if (step_cache.is_valid() && step_cache.config_matches()) {
+      TRACE_EVENT(TRACE_EVT_REPLAY, 0, step_cache.count);
+      step_cache.rewind();
+      render_state = RENDER_REPLAY;
+    } else if (!step_cache.is_full()) {
+      step_cache.start_recording();
     }
     break;
 
   case RENDER_BUFFER_SWAP:
 
-    if (inactive_point_buf->is_empty()) {
+    // A 'frame begin' since RENDER_BUFFER_END has taken the committed frame
+    // back - a normal host race, so keep drawing the front frame
+    if (!point_arena.back_ready) {
       stats.point_buf_repeat++;
       render_state = RENDER_GET_POINT;
-      return;
+      break;
     }
 
     if (!swap_buffers()) {
@@ -203,12 +507,18 @@ void Renderer::process() {
 
     break;
 
+  case RENDER_REPLAY:
+    replay_steps();
+    break;
+
   case ERROR_INTERP_FAULT:
+    TRACE_EVENT(TRACE_EVT_RENDER_FAULT, render_state, 0);
     DEBUG_ERROR(F("Renderer::process: Interpolation fault"));
     // TODO: Handle error gracefully
     render_state = IDLE_READY;
     break;
   case ERROR_BUFFER_FAULT:
+    TRACE_EVENT(TRACE_EVT_RENDER_FAULT, render_state, 0);
     DEBUG_ERROR(F("Renderer::process: Buffer fault"));
     // TODO: Handle error gracefully
     render_state = IDLE_EMPTY;
@@ -218,40 +528,243 @@ void Renderer::process() {
 
 bool Renderer::get_next_transition(transition_t *transition) {
 
-  if (active_point_buf->is_empty()) {
-    return false;
+  zone_t zone;
+  zone.build(g_config.renderer);
+
+  // The lit part of a segment, after the move to where it enters the zone
+  if (move_pending) {
+    move_pending = false;
+    transition_exact = false;
+    transition_shape = pending_move.shape;
+    transition->set_next(pending_move.point, pending_move.laser);
+    transition_clamped = zone_clamps(zone, *transition);
+    return true;
   }
 
-  if (point_buf_index == active_point_buf->get_point_count()) {
+  // The last curve is drawn - collect the next one's control points. The
+  // shape is reset too, so control points read before the end of the frame
+  // survive the call that finds the end.
+  if (transition_shape != MOVE_LINE) {
+    curve.clear();
+    transition_shape = MOVE_LINE;
+  }
+
+  const frame_region_t &frame = point_arena.front;
+
+  if (frame.is_empty()) {
     return false;
   }
 
+  // Decoded one point at a time - delta frames are never expanded. Segments
+  // entirely outside the safety zone are skipped. Control points at the end
+  // of the frame are kept for the segment back to the first point.
   point_coord8_t new_point;
-  active_point_buf->get_point(point_buf_index, &new_point);
+  zone_move_t moves[2];
+  uint8_t count = 0;
+  do {
+    if (!point_arena.next_point(frame, &frame_cursor, &new_point)) {
+      return false;
+    }
 
-  transition->set_next(
-      point_q12_4_t(COORD8_TO_Q12_4(new_point.x), COORD8_TO_Q12_4(new_point.y)),
-      new_point.flags & BLANKING_BIT);
+    point_q12_4_t position = transform.apply(new_point);
+    if (IS_CURVE_CONTROL(new_point.flags)) {
+      curve.add(position, new_point.flags, transform.mirrored);
+      continue;
+    }
+
+    count = clipper.next(zone, position, IS_LASER_ON(new_point.flags), curve,
+                         moves, &transition_exact);
+    if (count == 0 || moves[count - 1].shape == MOVE_LINE) {
+      curve.clear();
+    }
+  } while (count == 0);
+
+  transition_shape = moves[0].shape;
+  transition->set_next(moves[0].point, moves[0].laser);
+  transition_clamped = zone_clamps(zone, *transition);
+  if (count == 2) {
+    pending_move = moves[1];
+    move_pending = true;
+  }
 
-  point_buf_index++;
+  TRACE_EVENT(TRACE_EVT_TRANSITION, transition->laser_states,
+              (uint16_t)new_point.x << 8 | new_point.y);
 
   return true;
 }
 
+// A curve crossing the safety zone edge is drawn whole, so it and the moves
+// to and from its ends outside the zone have steps outside it
+bool Renderer::zone_clamps(const zone_t &zone,
+                           const transition_t &transition) const {
+  return zone.enabled && (transition_shape == MOVE_CURVE_CLIPPED ||
+                          !zone.contains(transition.start_point) ||
+                          !zone.contains(transition.end_point));
+}
+
+// Position of the current step - held on the safety zone edge where the
+// transition is outside it, so the scanner never leaves the zone
+point_q12_4_t Renderer::step_point() const {
+  if (!transition_clamped) {
+    return transition.current_point;
+  }
+  zone_t zone;
+  zone.build(g_config.renderer);
+  return zone.clamp(transition.current_point);
+}
+
+// Laser state of the current step - a curve crossing the safety zone edge is
+// blanked where it is outside
+bool Renderer::step_laser() const {
+  bool laser = transition.get_current_laser();
+  if (laser && transition_shape == MOVE_CURVE_CLIPPED) {
+    zone_t zone;
+    zone.build(g_config.renderer);
+    laser = zone.contains(transition.current_point);
+  }
+  return laser;
+}
+
+// Grid correction then pre-emphasis. The filter works on the corrected
+// positions - they are where the scanner is sent.
+inline point_q12_4_t Renderer::correct_step(point_q12_4_t point) {
+#if ENABLE_GRID
+  if (grid_active) {
+    point = grid_apply(point);
+  }
+#endif
+#if ENABLE_EMPHASIS
+  point = emphasis.apply(point);
+#endif
+  return point;
+}
+
+// Steps are corrected before the step cache, so replayed steps come out
+// already corrected and filtered
+void Renderer::push_step(point_q12_4_t point, bool laser) {
+  point = correct_step(point);
+  step_buf.push(point, laser);
+  step_cache.record(point, laser);
+
+#if ENABLE_FRAME_SUMMARY
+  if (summary_state == SUMMARY_COUNT) {
+    summary.total_steps++;
+    if (!laser) {
+      summary.blank_steps++;
+    }
+  }
+#endif
+}
+
+// Blanked hold at the current position - not recorded or counted, a pass
+// that only parks is never replayed
+void Renderer::park_step() {
+  step_buf.park(correct_step(step_point()));
+}
+
+// Called at the end of each pass. A generated frame is summed up over its
+// second pass, which starts from where the frame leaves the beam - the pass
+// compile_frame works out for other frames.
+void Renderer::count_summary_pass() {
+#if ENABLE_FRAME_SUMMARY
+  if (summary_state == SUMMARY_COUNT) {
+    summary.frame_us =
+        steps_to_us(summary.total_steps, g_config.timer.frequency);
+    summary_state = SUMMARY_DONE;
+  } else if (summary_state == SUMMARY_WAIT && !point_arena.back_ready) {
+    summary_state = SUMMARY_COUNT;
+  }
+#endif
+}
+
+// Times each pass, replayed ones also on their own - 'stats prof' then gives
+// the step cache hit rate
+void Renderer::profile_pass() {
+#if ENABLE_PROFILER
+  uint32_t now = clock_ticks();
+  profiler.record(PROFILE_FRAME_PASS, now - pass_start);
+  if (step_cache.replayed()) {
+    profiler.record(PROFILE_PASS_REPLAY, now - pass_start);
+  }
+  pass_start = now;
+#endif
+}
+
+// Fills the step ring from the step cache - no interpolation or dwell logic
+void Renderer::replay_steps() {
+  if (!step_cache.is_valid()) {
+    // The grid changed mid-pass. Carry on live from where the replay got
+    // to, with a move to the start of the frame.
+    transition.set_next(transition.current_point,
+                        transition.get_current_laser());
+    clipper.at = transition.current_point;
+    render_state = RENDER_GET_POINT;
+    return;
+  }
+
+  point_q12_4_t point;
+  bool laser;
+
+  while (!step_cache.replay_done()) {
+    if (step_buf.is_full()) {
+      stats.step_buf_wait++;
+      return;
+    }
+    stats.step_buf_wait = 0;
+
+    step_cache.replay(&point, &laser);
+    step_buf.push(point, laser);
+
+    transition.current_point = point;
+    transition.set_current_laser(laser);
+  }
+
+  render_state = RENDER_BUFFER_END;
+}
+
+// Curves are set up from their control points. Straight segments after the
+// first come from the frame's segment table when it was
+// computed with the current step sizes and the safety zone left the segment
+// alone - segment 0 depends on what was drawn before the frame, so it is
+// always worked out here
+void Renderer::start_interp() {
+  const frame_region_t &frame = point_arena.front;
+  uint8_t index = frame_cursor.index - 1;
+  const interp_settings_t &settings = transition_settings(
+      transition.get_start_laser(), transition.get_end_laser());
+
+  if (transition_shape != MOVE_LINE) {
+    interp_init_curve(&transition, curve, settings.step_size);
+  } else if (transition_exact && index > 0 && frame.has_table() &&
+      frame.table_step_size == interp_settings[INTERP_PROFILE_LIT].step_size &&
+      frame.table_blank_step_size ==
+          interp_settings[INTERP_PROFILE_BLANK].step_size &&
+      !frame.table_stale) {
+    segment_t segment;
+    point_arena.get_segment(frame, index, &segment);
+    interp_init_segment(&transition, segment, settings);
+  } else {
+    interp_init(&transition, settings);
+  }
+}
+
 bool Renderer::get_dwell() {
 
   // Calculate the laser dwell - depending on if the laser is going from on to
   // off or vice versa
 
-  if (transition.get_start_laser() == true &&
-      transition.get_end_laser() == false) {
-    this->dwell = g_config.renderer.laser_off_dwell;
-  } else if (transition.get_start_laser() == false &&
-             transition.get_end_laser() == true) {
-    this->dwell = g_config.renderer.laser_on_dwell;
-  } else {
-    this->dwell = 0;
-    return false;
-  }
-  return true;
+  bool start_laser = transition.get_start_laser();
+  bool end_laser = transition.get_end_laser();
+
+  // Corners are measured between the curve tangents
+  curve_t straight;
+  straight.clear();
+  const curve_t &shape = transition_shape == MOVE_LINE ? straight : curve;
+
+  this->dwell = transition_dwell(
+      last_move, shape.entry(transition.start_point, transition.end_point),
+      start_laser, end_laser);
+  last_move.update(shape.exit(transition.start_point, transition.end_point),
+                   !start_laser && !end_laser);
+  return this->dwell != 0;
 }
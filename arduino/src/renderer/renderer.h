@@ -1,11 +1,19 @@
 #pragma once
 #include "../config.h"
 #include "../debug.h"
+#include "../diagnostics/profiler.h"
 #include "../types.h"
 #include "buffers.h"
+#include "dwell.h"
+#include "emphasis.h"
+#include "grid.h"
 #include "interpolation.h"
+#include "transform.h"
+#include "zone.h"
 #include <Arduino.h>
 
+struct frame_pass_t;
+
 enum render_state_t {
   IDLE_EMPTY,
   IDLE_READY,
@@ -16,45 +24,137 @@ enum render_state_t {
   RENDER_INTERPOLATE,
   RENDER_BUFFER_END,
   RENDER_BUFFER_SWAP,
+  RENDER_REPLAY,
 
   ERROR_INTERP_FAULT,
   ERROR_BUFFER_FAULT,
 
 };
 
+// Summing up a generated frame as it is drawn - see commit_frame
+enum summary_state_t : uint8_t {
+  SUMMARY_DONE,
+  SUMMARY_WAIT,  // Committed, not drawn through once yet
+  SUMMARY_COUNT, // Counting the steps of this pass
+};
+
 class Renderer {
 
 public:
   void init();
-  void request_swap();
   void process();
+
+  // Frame upload - the pending frame is allocated from the point arena when
+  // it is started and swapped in at the end of the displayed frame once
+  // committed. Delta frames must be written in index order; generated
+  // frames are written as bytes and checked when committed.
+  bool begin_frame(uint8_t point_count,
+                   uint8_t format = FRAME_FORMAT_ABSOLUTE);
+  bool set_frame_point(uint8_t index, point_coord8_t point);
+  bool append_frame_byte(uint8_t byte);
+  bool commit_frame();
+  inline const point_arena_t &get_arena() const { return point_arena; }
+
+#if ENABLE_FRAME_SUMMARY
+  // Summary of the last committed frame - all 0 for a generated frame until
+  // it has been drawn through twice
+  inline const frame_summary_t &get_summary() const { return summary; }
+#endif
+
   inline bool get_next_step(point_q12_4_t *point, bool *laser_state) {
     return step_buf.pop(point, laser_state);
   }
 
+  // Apply g_config.renderer.emphasis_x/y to the step stream
+  inline void update_emphasis() {
+#if ENABLE_EMPHASIS
+    emphasis.configure(g_config.renderer.emphasis_x,
+                       g_config.renderer.emphasis_y);
+#endif
+  }
+
+  // Apply the transform settings in g_config.renderer from the next frame
+  void update_transform();
+
+  // Apply g_config.renderer.grid_correction - also after the grid is edited
+  void update_grid();
+
+  // Apply g_config.laser.delay to the step ring
+  inline void update_laser_delay() {
+    step_buf.set_laser_delay(g_config.laser.delay);
+  }
+
 private:
   step_ring_buf_16_t step_buf;
-  interpolation_t interp;
-  coord8_point_buf_t point_buf_a;
-  coord8_point_buf_t point_buf_b;
-  coord8_point_buf_t *active_point_buf;
-  coord8_point_buf_t *inactive_point_buf;
-  uint8_t point_buf_index;
-  bool swap_requested;
+  point_arena_t point_arena;
+  frame_cursor_t frame_cursor;
+  step_cache_t step_cache;
+#if ENABLE_EMPHASIS
+  emphasis_filter_t emphasis;
+#endif
+  transform_t transform;
+  bool transform_changed; // Set by update_transform until the next frame
+#if ENABLE_GRID
+  bool grid_active; // Correction on and a grid is loaded
+#endif
   render_state_t render_state;
 
   render_stats_t stats;
+#if ENABLE_FRAME_SUMMARY
+  frame_summary_t summary;
+  summary_state_t summary_state;
+#endif
   uint8_t dwell;
+  dwell_move_t last_move; // Move that arrived at the current point
 
   transition_t transition;
+  bool transition_exact; // Transition is the frame's segment, not clipped
+  move_shape_t transition_shape;
+  bool transition_clamped; // Steps outside the safety zone are held on its edge
+  curve_t curve; // Control points of the current or next curve
+
+  // Safety zone - the lit part of a segment that enters the zone waits here
+  // while the blanked move to the entry point is drawn
+  zone_clipper_t clipper;
+  zone_move_t pending_move;
+  bool move_pending;
+  bool pass_moved; // A transition came out of the pass so far
+#if ENABLE_PROFILER
+  uint32_t pass_start; // clock_ticks() at the start of the pass
+#endif
 
   bool swap_buffers();
   void process_next_point();
 
+  void push_step(point_q12_4_t point, bool laser);
+  void park_step();
+  point_q12_4_t correct_step(point_q12_4_t point);
+  void count_summary_pass();
+  void profile_pass();
+  point_q12_4_t step_point() const;
+  bool step_laser() const;
+  void replay_steps();
+
   bool get_next_transition(transition_t *transition);
+  bool zone_clamps(const zone_t &zone, const transition_t &transition) const;
+  void start_interp();
   bool get_dwell();
+
+  void compile_frame();
+  void compile_pass(const frame_region_t &frame, const transform_t &xf,
+                    const zone_t &zone, frame_pass_t *pass,
+                    frame_summary_t *summary, bool table);
+  inline bool transform_pending() const {
+    return transform_changed;
+  }
 };
 
+// The arena, step ring and step cache are budgeted on their own
+static_assert(sizeof(Renderer) - sizeof(point_arena_t) <=
+                  mem_budget::step_ring_bytes + mem_budget::step_cache_bytes +
+                      RENDERER_RAM_RESERVE,
+              "Renderer state exceeds RENDERER_RAM_RESERVE in config.h");
+
 // Global renderer instance
 extern Renderer renderer;
 
@@ -0,0 +1,59 @@
+#include "show.h"
+#include "renderer.h"
+
+Show show;
+
+void Show::init() {
+  frame = 0;
+  started_ms = 0;
+  duration_ms = 0;
+  running = show_frame_count > 0;
+  if (running) {
+    DEBUG_INFO(F("Show::init: Playing built in show"));
+  }
+}
+
+void Show::process() {
+  if (!running || renderer.get_arena().back_ready ||
+      millis() - started_ms < duration_ms) {
+    return;
+  }
+
+  show_frame_t entry;
+  memcpy_P(&entry, &show_frames[frame], sizeof(show_frame_t));
+  if (!upload(entry)) {
+    DEBUG_ERROR(F("Show::process: Frame does not fit, stopping"));
+    running = false;
+    return;
+  }
+
+  started_ms = millis();
+  duration_ms = entry.duration_ms;
+  if (++frame >= show_frame_count) {
+    frame = 0;
+  }
+
+  // A single frame stays up without being uploaded again
+  if (show_frame_count == 1) {
+    running = false;
+  }
+}
+
+bool Show::upload(const show_frame_t &entry) {
+  if (!renderer.begin_frame(0, FRAME_FORMAT_SPRITES)) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < entry.sprite_count; i++) {
+    sprite_instance_t instance = {
+        (uint8_t)(entry.sprite + i), 128, 128, SPRITE_SCALE_ONE, 0,
+        i == 0 ? SPRITE_JUMP : SPRITE_CONNECT};
+    const uint8_t *record = (const uint8_t *)&instance;
+    for (uint8_t j = 0; j < sizeof(sprite_instance_t); j++) {
+      if (!renderer.append_frame_byte(record[j])) {
+        return false;
+      }
+    }
+  }
+  return renderer.commit_frame();
+}
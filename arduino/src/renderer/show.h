@@ -0,0 +1,57 @@
+#pragma once
+
+#include "sprite.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * BUILT IN SHOW
+ * ============================================================================
+ *
+ * The show is compiled into flash at build time by show_compiler.py (run
+ * from extra_script.py) from the ILDA and SVG files in the show folder. It
+ * generates show_data.cpp in the build dir with:
+ *
+ *   show_sprite_table - every frame's outline as sprites, ids from
+ *                       SPRITE_BUILTIN_COUNT up
+ *   show_frames       - the frames in order, each a run of sprites drawn
+ *                       one after another
+ *
+ * Frames longer than a sprite are split over several, joined with
+ * SPRITE_CONNECT. The player uploads each frame as a sprite list when its
+ * time is up, so a standalone installation draws its show from boot with
+ * no host. It stops for good as soon as the host starts a frame.
+ *
+ * ============================================================================
+ */
+
+struct show_frame_t {
+  uint8_t sprite;       // First sprite id
+  uint8_t sprite_count; // Sprites in the frame
+  uint16_t duration_ms; // Time shown
+};
+
+// Generated - show_data.cpp in the build dir
+extern const sprite_t show_sprite_table[] PROGMEM;
+extern const uint8_t show_sprite_count;
+extern const show_frame_t show_frames[] PROGMEM;
+extern const uint16_t show_frame_count;
+
+class Show {
+
+public:
+  void init();
+  void process();
+  inline void stop() { running = false; }
+  inline bool is_running() const { return running; }
+
+private:
+  bool running;
+  uint16_t frame;      // Next frame to upload
+  uint32_t started_ms; // When the displayed frame was uploaded
+  uint16_t duration_ms;
+
+  bool upload(const show_frame_t &entry);
+};
+
+extern Show show;
@@ -0,0 +1,114 @@
+#include "sprite.h"
+#include "show.h"
+#include "transform.h"
+#include <avr/pgmspace.h>
+
+static const sprite_point_t square_points[] PROGMEM = {
+    {-32, -32, 0}, {32, -32, 0}, {32, 32, 0}, {-32, 32, 0}, {-32, -32, 0}};
+
+static const sprite_point_t triangle_points[] PROGMEM = {
+    {0, 32, 0}, {-28, -16, 0}, {28, -16, 0}, {0, 32, 0}};
+
+// A full turn arc - start, centre, back to the start
+static const sprite_point_t circle_points[] PROGMEM = {
+    {32, 0, 0}, {0, 0, ARC_CENTRE_BIT}, {32, 0, 0}};
+
+static const sprite_point_t star_points[] PROGMEM = {
+    {0, 32, 0},   {-19, -26, 0}, {30, 10, 0},
+    {-30, 10, 0}, {19, -26, 0},  {0, 32, 0}};
+
+static const sprite_point_t arrow_points[] PROGMEM = {
+    {-32, 0, 0},
+    {32, 0, 0},
+    {16, 16, 0},
+    {32, 0, BLANKING_BIT},
+    {16, -16, 0}};
+
+static const sprite_point_t cross_points[] PROGMEM = {
+    {-32, 0, 0}, {32, 0, 0}, {0, -32, BLANKING_BIT}, {0, 32, 0}};
+
+#define SPRITE_ENTRY(points) {points, sizeof(points) / sizeof(sprite_point_t)}
+
+// In sprite_id_t order
+static const sprite_t builtin_sprites[SPRITE_BUILTIN_COUNT] PROGMEM = {
+    SPRITE_ENTRY(square_points), SPRITE_ENTRY(triangle_points),
+    SPRITE_ENTRY(circle_points), SPRITE_ENTRY(star_points),
+    SPRITE_ENTRY(arrow_points),  SPRITE_ENTRY(cross_points),
+};
+
+uint8_t sprite_count() { return SPRITE_BUILTIN_COUNT + show_sprite_count; }
+
+void sprite_read(uint8_t id, sprite_t *sprite) {
+  const sprite_t *entry = id < SPRITE_BUILTIN_COUNT
+                              ? &builtin_sprites[id]
+                              : &show_sprite_table[id - SPRITE_BUILTIN_COUNT];
+  memcpy_P(sprite, entry, sizeof(sprite_t));
+}
+
+bool sprite_count_points(const uint8_t *data, uint16_t length,
+                         uint16_t *points) {
+  uint8_t count = sprite_count();
+  *points = 0;
+  for (uint16_t pos = 0; pos < length; pos += sizeof(sprite_instance_t)) {
+    if (pos + sizeof(sprite_instance_t) > length) {
+      return false;
+    }
+
+    sprite_instance_t instance;
+    memcpy(&instance, data + pos, sizeof(sprite_instance_t));
+    if (instance.sprite >= count ||
+        instance.policy >= SPRITE_POLICY_COUNT) {
+      return false;
+    }
+
+    if (instance.policy != SPRITE_HIDDEN) {
+      sprite_t sprite;
+      sprite_read(instance.sprite, &sprite);
+      *points += sprite.count;
+    }
+  }
+  return true;
+}
+
+// Origin plus offset rotated and scaled (Q1.14 times 1/64ths), clamped
+static inline uint8_t sprite_place(uint8_t origin, int32_t offset) {
+  int32_t out = origin + ((offset + (1L << 19)) >> 20);
+  return constrain(out, 0, 255);
+}
+
+bool sprite_next_point(const uint8_t *data, uint16_t length, uint16_t *pos,
+                       uint8_t *element, point_coord8_t *point) {
+  for (; *pos + sizeof(sprite_instance_t) <= length;
+       *pos += sizeof(sprite_instance_t), *element = 0) {
+    sprite_instance_t instance;
+    memcpy(&instance, data + *pos, sizeof(sprite_instance_t));
+    if (instance.policy == SPRITE_HIDDEN ||
+        instance.sprite >= sprite_count()) {
+      continue;
+    }
+
+    sprite_t sprite;
+    sprite_read(instance.sprite, &sprite);
+    if (*element >= sprite.count) {
+      continue;
+    }
+
+    sprite_point_t p;
+    memcpy_P(&p, &sprite.points[*element], sizeof(sprite_point_t));
+
+    uint8_t flags = p.flags & ~LAST_POINT_BIT;
+    if (*element == 0 && instance.policy == SPRITE_JUMP) {
+      flags |= BLANKING_BIT;
+    }
+    (*element)++;
+
+    int32_t sine = transform_sin(instance.angle);
+    int32_t cosine = transform_sin(instance.angle + 64);
+    *point = point_coord8_t(
+        sprite_place(instance.x, (cosine * p.x - sine * p.y) * instance.scale),
+        sprite_place(instance.y, (sine * p.x + cosine * p.y) * instance.scale),
+        flags);
+    return true;
+  }
+  return false;
+}
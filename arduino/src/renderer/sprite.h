@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * SPRITES
+ * ============================================================================
+ *
+ * Sprite outlines live in flash and are never copied to RAM. The built in
+ * ones come first, then the show's (see show.h).
+ *
+ * A FRAME_FORMAT_SPRITES frame only holds a list of instances, 6 bytes each:
+ *
+ *   sprite x y scale angle policy
+ *
+ * x/y place the sprite origin in coord8. scale is in 1/SPRITE_SCALE_ONE
+ * ths, angle is 256 per turn counterclockwise, both about the origin. The
+ * renderer reads the frame through point_arena_t::next_point, which works
+ * out each point from flash as it is needed - one instance after another.
+ *
+ * policy says how an instance is reached from the point before it:
+ *
+ *   SPRITE_JUMP      blanked move to its first point
+ *   SPRITE_CONNECT   the first point keeps its own flags (lit for the
+ *                    built in sprites), joining the outlines
+ *   SPRITE_HIDDEN    not drawn - keeps its slot for a later upload
+ *
+ * Sprite points are signed offsets from the origin. Curve and arc flags work
+ * as in any other frame, since the instance transform has no mirroring.
+ * Points pushed off the field are clamped to its edge.
+ *
+ * ============================================================================
+ */
+
+#define SPRITE_SCALE_ONE 64 // scale for 1:1
+
+enum sprite_policy_t : uint8_t {
+  SPRITE_JUMP,
+  SPRITE_CONNECT,
+  SPRITE_HIDDEN,
+  SPRITE_POLICY_COUNT
+};
+
+// Built in sprites, +/-32 around the origin
+enum sprite_id_t : uint8_t {
+  SPRITE_SQUARE,
+  SPRITE_TRIANGLE,
+  SPRITE_CIRCLE,
+  SPRITE_STAR,
+  SPRITE_ARROW,
+  SPRITE_CROSS,
+  SPRITE_BUILTIN_COUNT
+};
+
+struct sprite_point_t {
+  int8_t x, y;
+  uint8_t flags;
+};
+
+struct sprite_t {
+  const sprite_point_t *points; // PROGMEM
+  uint8_t count;
+};
+
+struct sprite_instance_t {
+  uint8_t sprite;
+  uint8_t x, y;
+  uint8_t scale;
+  uint8_t angle;
+  uint8_t policy;
+};
+
+// Sprites available - built in and show
+uint8_t sprite_count();
+
+// Copy sprite id (< sprite_count()) out of flash
+void sprite_read(uint8_t id, sprite_t *sprite);
+
+// Points one pass of the instances in data (length bytes) outputs
+// Returns false if a record is truncated or names a bad sprite or policy
+bool sprite_count_points(const uint8_t *data, uint16_t length,
+                         uint16_t *points);
+
+// Next point of the instances in data. pos is the byte offset of the
+// current instance, element the next point of its sprite - both 0 to start.
+// Returns false at the end of the list
+bool sprite_next_point(const uint8_t *data, uint16_t length, uint16_t *pos,
+                       uint8_t *element, point_coord8_t *point);
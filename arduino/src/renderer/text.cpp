@@ -0,0 +1,91 @@
+#include "text.h"
+#include "font.h"
+
+// Font units to coord8, rounded
+static inline int16_t text_scale(int16_t units, uint8_t size) {
+  return (units * size + (TEXT_SIZE_ONE / 2)) >> TEXT_SIZE_SHIFT;
+}
+
+static inline bool text_on_field(int16_t x, int16_t y) {
+  return x >= 0 && x <= 255 && y >= 0 && y <= 255;
+}
+
+bool text_count_points(const uint8_t *data, uint16_t length,
+                       uint16_t *points) {
+  for (uint16_t pos = 0; pos < length; pos += TEXT_RUN_HEADER + data[pos + 5]) {
+    if (pos + TEXT_RUN_HEADER > length ||
+        pos + TEXT_RUN_HEADER + data[pos + 5] > length) {
+      return false;
+    }
+  }
+
+  uint16_t pos = 0;
+  text_state_t state;
+  state.reset();
+  point_coord8_t point;
+
+  *points = 0;
+  while (text_next_point(data, length, &pos, &state, &point)) {
+    (*points)++;
+  }
+  return true;
+}
+
+bool text_next_point(const uint8_t *data, uint16_t length, uint16_t *pos,
+                     text_state_t *state, point_coord8_t *point) {
+  while (*pos + TEXT_RUN_HEADER <= length) {
+    text_run_t run;
+    run.x = (int16_t)(data[*pos] | (data[*pos + 1] << 8));
+    run.y = data[*pos + 2];
+    run.size = data[*pos + 3];
+    run.spacing = (int8_t)data[*pos + 4];
+    run.length = data[*pos + 5];
+
+    if (state->character >= run.length ||
+        *pos + TEXT_RUN_HEADER + run.length > length) {
+      *pos += TEXT_RUN_HEADER + run.length;
+      state->reset();
+      continue;
+    }
+
+    if (state->character == 0 && state->vertex == 0) {
+      state->pen_x = run.x;
+    }
+
+    font_glyph_t glyph;
+    font_glyph(data[*pos + TEXT_RUN_HEADER + state->character], &glyph);
+
+    int16_t right = state->pen_x + text_scale(glyph.width, run.size);
+    bool visible =
+        right >= 0 && state->pen_x <= 255 &&
+        run.y + text_scale(FONT_ASCENT, run.size) >= 0 &&
+        run.y + text_scale(FONT_DESCENT, run.size) <= 255;
+
+    if (visible && state->vertex < glyph.count) {
+      font_vertex_t vertex;
+      font_vertex(glyph.start + state->vertex, &vertex);
+      state->vertex++;
+
+      int16_t x = state->pen_x + text_scale(vertex.x & ~FONT_MOVE, run.size);
+      int16_t y = run.y + text_scale(vertex.y, run.size);
+      bool off = !text_on_field(x, y);
+
+      uint8_t flags = 0;
+      if ((vertex.x & FONT_MOVE) || off || state->clipped) {
+        flags = BLANKING_BIT;
+      }
+      state->clipped = off;
+
+      *point =
+          point_coord8_t(constrain(x, 0, 255), constrain(y, 0, 255), flags);
+      return true;
+    }
+
+    // Next character - saturates so a long run off the right stays there
+    int16_t advance = text_scale(glyph.width, run.size) + run.spacing;
+    state->pen_x = constrain((int32_t)state->pen_x + advance, -0x7FFF, 0x7FFF);
+    state->character++;
+    state->vertex = 0;
+  }
+  return false;
+}
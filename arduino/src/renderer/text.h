@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * TEXT
+ * ============================================================================
+ *
+ * A FRAME_FORMAT_TEXT frame holds runs of text, drawn in the stroke font (see
+ * font.h). Each run is a 6 byte header and its characters:
+ *
+ *   x_lo x_hi y size spacing length chars...
+ *
+ * x (int16) and y place the left end of the baseline in coord8. x can be off
+ * the field either side, so a host scrolls text by changing only x. size is
+ * in 1/TEXT_SIZE_ONE ths of a coord8 per font unit, so capitals are
+ * FONT_CAP_HEIGHT * size / TEXT_SIZE_ONE high. spacing (signed) is added
+ * after every character.
+ *
+ * Glyphs wholly off the field are skipped. Points off the field are clamped
+ * to its edge, and any stroke to or from one is blanked.
+ *
+ * ============================================================================
+ */
+
+#define TEXT_SIZE_ONE 16 // size for one coord8 per font unit
+#define TEXT_SIZE_SHIFT 4
+#define TEXT_RUN_HEADER 6
+
+struct text_run_t {
+  int16_t x;
+  uint8_t y;
+  uint8_t size;
+  int8_t spacing;
+  uint8_t length;
+};
+
+// Position within a run - part of frame_cursor_t
+struct text_state_t {
+  int16_t pen_x;     // Left edge of the current character
+  uint8_t character; // Current character of the run
+  uint8_t vertex;    // Next vertex of its glyph
+  bool clipped;      // Last point was off the field
+
+  inline void reset() {
+    pen_x = 0;
+    character = 0;
+    vertex = 0;
+    clipped = false;
+  }
+};
+
+// Points one pass of the runs in data (length bytes) outputs
+// Returns false if a run is truncated
+bool text_count_points(const uint8_t *data, uint16_t length,
+                       uint16_t *points);
+
+// Next point of the runs in data. pos is the byte offset of the current run,
+// 0 with state reset to start.
+// Returns false at the end of the runs
+bool text_next_point(const uint8_t *data, uint16_t length, uint16_t *pos,
+                     text_state_t *state, point_coord8_t *point);
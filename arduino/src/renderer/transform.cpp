@@ -0,0 +1,75 @@
+#include "transform.h"
+#include <avr/pgmspace.h>
+
+// Quarter wave sine table, 65 entries for 0..90 degrees in Q1.14, worked out
+// by the compiler from a Taylor series (exact to well under 1 LSB)
+static constexpr double sine_step = 3.14159265358979 / 128;
+
+static constexpr double sine_poly(double x, double x2) {
+  return x * (1 - x2 / 6 *
+                      (1 - x2 / 20 *
+                               (1 - x2 / 42 * (1 - x2 / 72 * (1 - x2 / 110)))));
+}
+
+static constexpr int16_t sine_q14(uint8_t i) {
+  return (int16_t)(sine_poly(i * sine_step, (i * sine_step) * (i * sine_step)) *
+                       16384 +
+                   0.5);
+}
+
+#define SINE4(i) sine_q14(i), sine_q14(i + 1), sine_q14(i + 2), sine_q14(i + 3)
+#define SINE16(i) SINE4(i), SINE4(i + 4), SINE4(i + 8), SINE4(i + 12)
+
+static const int16_t sine_table[65] PROGMEM = {
+    SINE16(0), SINE16(16), SINE16(32), SINE16(48), sine_q14(64)};
+
+int16_t transform_sin(uint8_t angle) {
+  uint8_t i = angle & 63;
+  switch (angle >> 6) {
+  case 0:
+    return pgm_read_word(&sine_table[i]);
+  case 1:
+    return pgm_read_word(&sine_table[64 - i]);
+  case 2:
+    return -pgm_read_word(&sine_table[i]);
+  default:
+    return -pgm_read_word(&sine_table[64 - i]);
+  }
+}
+
+void transform_t::build(const config_t::renderer_config_t &config) {
+  identity = config.transform_scale == TRANSFORM_SCALE_ONE &&
+             config.transform_angle == 0 && config.transform_x == 0 &&
+             config.transform_y == 0 && !config.flip_x && !config.flip_y &&
+             !config.swap_xy;
+  mirrored = config.swap_xy ^ config.flip_x ^ config.flip_y;
+
+  // Flip/swap matrix, applied to the point first
+  int8_t f00 = 1, f01 = 0, f10 = 0, f11 = 1;
+  if (config.swap_xy) {
+    f00 = 0, f01 = 1, f10 = 1, f11 = 0;
+  }
+  if (config.flip_x) {
+    f00 = -f00, f01 = -f01;
+  }
+  if (config.flip_y) {
+    f10 = -f10, f11 = -f11;
+  }
+
+  // Rotation times flip/swap in Q1.14, then scale (1/64ths) down to Q4.12
+  int32_t sine = transform_sin(config.transform_angle);
+  int32_t cosine = transform_sin(config.transform_angle + 64);
+  uint8_t scale = config.transform_scale;
+
+  a = ((cosine * f00 - sine * f10) * scale) >> 8;
+  b = ((cosine * f01 - sine * f11) * scale) >> 8;
+  c = ((sine * f00 + cosine * f10) * scale) >> 8;
+  d = ((sine * f01 + cosine * f11) * scale) >> 8;
+
+  // Pivot about the centre of the field, then offset
+  int32_t centre = TRANSFORM_CENTRE;
+  tx = centre + COORD8_TO_Q12_4(1) * config.transform_x -
+       (((int32_t)a * centre + (int32_t)b * centre) >> TRANSFORM_SHIFT);
+  ty = centre + COORD8_TO_Q12_4(1) * config.transform_y -
+       (((int32_t)c * centre + (int32_t)d * centre) >> TRANSFORM_SHIFT);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../config.h"
+#include "../types.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * AFFINE TRANSFORM
+ * ============================================================================
+ *
+ * Every frame point goes through a 2x3 fixed-point matrix on its way into a
+ * transition:
+ *
+ *   x' = (a * x + b * y) >> TRANSFORM_SHIFT + tx
+ *   y' = (c * x + d * y) >> TRANSFORM_SHIFT + ty
+ *
+ * a..d are Q4.12, x/y and tx/ty are Q12.4. The matrix is built from
+ * g_config.renderer - scale, rotation and offset about the centre of the
+ * field, with flip_x, flip_y and swap_xy applied first. Sine and cosine come
+ * from a quarter wave table generated at compile time.
+ *
+ * ============================================================================
+ */
+
+#define TRANSFORM_SHIFT 12
+#define TRANSFORM_SCALE_ONE 64 // transform_scale for 1:1
+#define TRANSFORM_CENTRE COORD8_TO_Q12_4(128)
+#define TRANSFORM_MAX_OUTPUT 0x0FFF // DAC full scale
+
+struct transform_t {
+  int16_t a, b, c, d; // Q4.12
+  int16_t tx, ty;     // Q12.4, centre correction included
+  bool identity;      // Skip the multiplies
+  bool mirrored;      // One flip or a swap - turns run the other way
+
+  void build(const config_t::renderer_config_t &config);
+
+  inline point_q12_4_t apply(point_coord8_t point) const {
+    int16_t x = COORD8_TO_Q12_4(point.x);
+    int16_t y = COORD8_TO_Q12_4(point.y);
+    if (identity) {
+      return point_q12_4_t(x, y);
+    }
+
+    int32_t out_x = (((int32_t)a * x + (int32_t)b * y) >> TRANSFORM_SHIFT) + tx;
+    int32_t out_y = (((int32_t)c * x + (int32_t)d * y) >> TRANSFORM_SHIFT) + ty;
+    return point_q12_4_t(constrain(out_x, 0, TRANSFORM_MAX_OUTPUT),
+                         constrain(out_y, 0, TRANSFORM_MAX_OUTPUT));
+  }
+};
+
+// Sine of a binary angle (256 per turn) in Q1.14
+int16_t transform_sin(uint8_t angle);
@@ -0,0 +1,112 @@
+#include "zone.h"
+
+// Each end is moved onto at most two edges, so four passes always settle.
+// Rounding can leave a point a fraction outside - the clamp takes it back.
+#define ZONE_CLIP_PASSES 4
+
+bool zone_t::clip(point_q12_4_t *a, point_q12_4_t *b) const {
+  uint8_t code_a = outcode(*a);
+  uint8_t code_b = outcode(*b);
+
+  for (uint8_t pass = 0; pass < ZONE_CLIP_PASSES; pass++) {
+    if (!(code_a | code_b)) {
+      return true;
+    }
+    if (code_a & code_b) {
+      return false; // Both ends past the same edge
+    }
+
+    // Move the end that is outside onto the edge it is past. The other end
+    // is not past that edge, so the division is never by 0.
+    uint8_t code = code_a ? code_a : code_b;
+    int32_t dx = b->x - a->x;
+    int32_t dy = b->y - a->y;
+    point_q12_4_t edge;
+
+    if (code & (ZONE_OUT_TOP | ZONE_OUT_BOTTOM)) {
+      edge.y = code & ZONE_OUT_TOP ? y_max : y_min;
+      edge.x = a->x + dx * (edge.y - a->y) / dy;
+    } else {
+      edge.x = code & ZONE_OUT_RIGHT ? x_max : x_min;
+      edge.y = a->y + dy * (edge.x - a->x) / dx;
+    }
+
+    if (code_a) {
+      *a = edge;
+      code_a = outcode(*a);
+    } else {
+      *b = edge;
+      code_b = outcode(*b);
+    }
+  }
+
+  *a = clamp(*a);
+  *b = clamp(*b);
+  return true;
+}
+
+uint8_t zone_clipper_t::next(const zone_t &zone, point_q12_4_t to,
+                             bool laser, const curve_t &curve,
+                             zone_move_t moves[2], bool *exact) {
+  point_q12_4_t start = from;
+  bool was_at_from = at == from;
+  bool curved = laser && curve.count;
+  from = to;
+
+  if (!zone.enabled) {
+    *exact = was_at_from && !curved;
+    at = to;
+    moves[0] = {to, laser, curved ? MOVE_CURVE : MOVE_LINE};
+    return 1;
+  }
+
+  if (!laser) {
+    point_q12_4_t end = zone.clamp(to);
+    *exact = was_at_from && end == to;
+    at = end;
+    moves[0] = {end, false, MOVE_LINE};
+    return 1;
+  }
+
+  point_q12_4_t end = to;
+  move_shape_t shape = MOVE_LINE;
+  *exact = false;
+
+  if (curved) {
+    uint8_t code_all = zone.outcode(start) & zone.outcode(to);
+    uint8_t code_any = zone.outcode(start) | zone.outcode(to);
+    if (curve.is_arc()) {
+      // The box around the whole circle - |dx| + |dy| is never less than
+      // the radius
+      point_q12_4_t radius = start - curve.control[0];
+      int16_t r = ABS(radius.x) + ABS(radius.y);
+      uint8_t code_low = zone.outcode(curve.control[0] - point_q12_4_t(r, r));
+      uint8_t code_high = zone.outcode(curve.control[0] + point_q12_4_t(r, r));
+      code_all &= code_low & code_high;
+      code_any |= code_low | code_high;
+    } else {
+      for (uint8_t i = 0; i < curve.count; i++) {
+        uint8_t code = zone.outcode(curve.control[i]);
+        code_all &= code;
+        code_any |= code;
+      }
+    }
+    if (code_all) {
+      return 0;
+    }
+    shape = code_any ? MOVE_CURVE_CLIPPED : MOVE_CURVE;
+  } else if (!zone.clip(&start, &end)) {
+    return 0;
+  }
+
+  // A curve keeps its own start, even outside the zone - the renderer holds
+  // the steps out there on the zone edge
+  uint8_t count = 0;
+  if (!(start == at)) {
+    moves[count++] = {start, false, MOVE_LINE};
+  }
+  moves[count++] = {end, true, shape};
+  *exact = count == 1 && !curved && was_at_from && end == to;
+  at = end;
+  return count;
+}
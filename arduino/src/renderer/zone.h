@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../config.h"
+#include "../types.h"
+#include "curve.h"
+#include <Arduino.h>
+
+/*
+ * ============================================================================
+ * SAFETY ZONE
+ * ============================================================================
+ *
+ * A rectangle the laser may only be lit inside, set in coord8 units in
+ * g_config.renderer and applied after the transform - it holds whatever the
+ * frame is scaled, rotated or offset to.
+ *
+ * Lit segments are clipped to the zone with Cohen-Sutherland in Q12.4. The
+ * part outside is not drawn: if the segment enters the zone somewhere other
+ * than where the beam is, a blanked move to the entry point comes first, and
+ * segments entirely outside are skipped - they cost no steps at all. Blanked
+ * moves end at the nearest point inside the zone, so the scanner never leaves
+ * it either.
+ *
+ * Curves are tested by their control points, which the curve never strays
+ * outside, and arcs by the square around their whole circle. A curve that
+ * crosses the zone edge is drawn whole with the laser off for the steps
+ * outside the zone. Its ends can be outside too, so the renderer holds those
+ * steps, and the ones of the moves to and from the ends, on the zone edge.
+ *
+ * ============================================================================
+ */
+
+#define ZONE_OUT_LEFT 0x01
+#define ZONE_OUT_RIGHT 0x02
+#define ZONE_OUT_BOTTOM 0x04
+#define ZONE_OUT_TOP 0x08
+
+// A bound of 255 takes in the whole last coord8 step of the DAC range
+#define ZONE_MAX_FRACTION (Q12_4_SCALE_FACTOR - 1)
+
+struct zone_t {
+  int16_t x_min, y_min, x_max, y_max; // Q12.4, inclusive
+  bool enabled;
+
+  inline void build(const config_t::renderer_config_t &config) {
+    enabled = config.zone_enabled;
+    x_min = COORD8_TO_Q12_4(config.zone_x_min);
+    y_min = COORD8_TO_Q12_4(config.zone_y_min);
+    x_max = COORD8_TO_Q12_4(config.zone_x_max) + ZONE_MAX_FRACTION;
+    y_max = COORD8_TO_Q12_4(config.zone_y_max) + ZONE_MAX_FRACTION;
+  }
+
+  inline uint8_t outcode(point_q12_4_t point) const {
+    uint8_t code = 0;
+    if (point.x < x_min) {
+      code |= ZONE_OUT_LEFT;
+    } else if (point.x > x_max) {
+      code |= ZONE_OUT_RIGHT;
+    }
+    if (point.y < y_min) {
+      code |= ZONE_OUT_BOTTOM;
+    } else if (point.y > y_max) {
+      code |= ZONE_OUT_TOP;
+    }
+    return code;
+  }
+
+  inline bool contains(point_q12_4_t point) const {
+    return outcode(point) == 0;
+  }
+
+  inline point_q12_4_t clamp(point_q12_4_t point) const {
+    return point_q12_4_t(constrain(point.x, x_min, x_max),
+                         constrain(point.y, y_min, y_max));
+  }
+
+  // Clip the segment a -> b to the zone, false if none of it is inside
+  bool clip(point_q12_4_t *a, point_q12_4_t *b) const;
+};
+
+struct zone_move_t {
+  point_q12_4_t point;
+  bool laser;
+  move_shape_t shape;
+};
+
+// Turns the frame's segments into the moves drawn inside the zone
+struct zone_clipper_t {
+  point_q12_4_t from; // Last frame point, unclipped
+  point_q12_4_t at;   // Where the last move ended
+
+  inline void reset(point_q12_4_t point) { from = at = point; }
+
+  // Moves for the segment from the last drawn frame point to `to`, through
+  // curve's control points - 0 if it is skipped, 2 if a blanked move to where
+  // it enters the zone comes first. exact is set if the one move is a
+  // straight segment, unchanged.
+  uint8_t next(const zone_t &zone, point_q12_4_t to, bool laser,
+               const curve_t &curve, zone_move_t moves[2], bool *exact);
+};
@@ -194,6 +194,34 @@ struct transition_t {
   }
 };
 
+/*
+segment_t is the precomputed part of a transition - how many steps it takes and
+how far each step moves. It depends only on the two end points and the step
+size, so it can be worked out once when a frame is committed.
+
+steps == 0 marks a move shorter than one step, which goes straight to the end
+point without acceleration or deceleration.
+*/
+struct segment_t {
+  point_q12_4_t step; // Per-step increment
+  uint8_t steps;      // Total steps, 0 for a short move
+
+  segment_t() : step(0, 0), steps(0) {}
+};
+
+// Frame statistics worked out when a frame is committed
+struct frame_summary_t {
+  uint32_t total_steps; // Output steps for one pass, including dwell
+  uint32_t blank_steps; // Of which the laser is blanked
+  uint32_t frame_us;    // One pass at the current timer frequency
+
+  frame_summary_t() : total_steps(0), blank_steps(0), frame_us(0) {}
+
+  inline uint8_t blank_percent() const {
+    return total_steps ? (uint8_t)((blank_steps * 100) / total_steps) : 0;
+  }
+};
+
 struct render_stats_t {
   uint8_t point_buf_wait;
   uint8_t point_buf_repeat;
@@ -221,15 +249,21 @@ As per ILDA IDTF:
 Bit 7 (MSB) - Last Point Bit - always 0 except last point of image
 Bit 6 - Blanking Bit - if 1, laser is off. If 0, laser is on.
 
-Bits 0 - 5 are unused in the IDTF and reserved here for future use.
+Bits 0 - 5 are unused in the IDTF. Bits 0 - 2 mark curve control points and
+arc centres (see renderer/curve.h), bits 3 - 5 are reserved here for future
+use.
 */
 enum PointFlagBits {
-  LAST_POINT_BIT = 0x80, // Bit 7 - always 0 except last point of image
-  BLANKING_BIT = 0x40    // Bit 6 - if 1, laser is off
+  LAST_POINT_BIT = 0x80,    // Bit 7 - always 0 except last point of image
+  BLANKING_BIT = 0x40,      // Bit 6 - if 1, laser is off
+  ARC_CLOCKWISE_BIT = 0x04, // Bit 2 - arc centre only, if 1 arc is clockwise
+  ARC_CENTRE_BIT = 0x02,    // Bit 1 - if 1, arc centre, not drawn
+  CURVE_CONTROL_BIT = 0x01  // Bit 0 - if 1, control point, not drawn
 };
 
 #define IS_LASER_ON(flags) (!(flags & BLANKING_BIT))
 #define IS_LAST_POINT(flags) (flags & LAST_POINT_BIT)
+#define IS_CURVE_CONTROL(flags) (flags & (CURVE_CONTROL_BIT | ARC_CENTRE_BIT))
 
 enum SystemMode { MODE_DUAL_BUFFER = 0, MODE_COUNT };
 
@@ -0,0 +1,72 @@
+// Correction grid clearing and cell cache - run on the board with 'pio test'.
+// Overwrites the grid stored in EEPROM.
+#include "renderer/grid.h"
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <unity.h>
+
+void setUp() {}
+void tearDown() {}
+
+// Polls until the background clear finishes, or gives up
+static bool finish_clear() {
+  for (uint16_t i = 0; i < 10000; i++) {
+    if (grid_poll()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The first write starts the clear but keeps the node, even if it is written
+// again while the clear runs
+void test_clear_in_background() {
+  for (uint8_t i = 0; i < GRID_EEPROM_BYTES; i++) {
+    EEPROM.update(GRID_EEPROM_ADDRESS + i, 0xFF);
+  }
+  grid_set_node(3, 1, {5, -7});
+  TEST_ASSERT_FALSE(grid_is_loaded());
+  TEST_ASSERT_FALSE(grid_poll());
+  grid_set_node(0, 4, {-9, 11});
+  TEST_ASSERT_TRUE(finish_clear());
+  TEST_ASSERT_TRUE(grid_is_loaded());
+
+  for (uint8_t row = 0; row < GRID_NODES; row++) {
+    for (uint8_t col = 0; col < GRID_NODES; col++) {
+      grid_node_t node = grid_get_node(col, row);
+      int16_t x = col == 3 && row == 1 ? 5 : col == 0 && row == 4 ? -9 : 0;
+      int16_t y = col == 3 && row == 1 ? -7 : col == 0 && row == 4 ? 11 : 0;
+      TEST_ASSERT_EQUAL_INT16(x, node.x);
+      TEST_ASSERT_EQUAL_INT16(y, node.y);
+    }
+  }
+  TEST_ASSERT_FALSE(grid_poll());
+}
+
+// Steps within a cell reuse its nodes - a node write or another cell must
+// still be seen
+void test_cell_cache() {
+  grid_set_node(1, 1, {16, -16});
+  point_q12_4_t node(GRID_CELL_SIZE, GRID_CELL_SIZE);
+  point_q12_4_t half(GRID_CELL_SIZE + GRID_CELL_SIZE / 2, GRID_CELL_SIZE);
+  TEST_ASSERT_TRUE(grid_apply(node) == point_q12_4_t(node.x + 16, node.y - 16));
+  TEST_ASSERT_TRUE(grid_apply(half) == point_q12_4_t(half.x + 8, half.y - 8));
+
+  grid_set_node(1, 1, {32, 0});
+  TEST_ASSERT_TRUE(grid_apply(half) == point_q12_4_t(half.x + 16, half.y));
+
+  grid_set_node(2, 2, {0, 64});
+  point_q12_4_t other(GRID_CELL_SIZE * 2, GRID_CELL_SIZE * 2);
+  TEST_ASSERT_TRUE(grid_apply(half) == point_q12_4_t(half.x + 16, half.y));
+  TEST_ASSERT_TRUE(grid_apply(other) == point_q12_4_t(other.x, other.y + 64));
+}
+
+void setup() {
+  delay(2000); // Let the serial monitor attach
+  UNITY_BEGIN();
+  RUN_TEST(test_clear_in_background);
+  RUN_TEST(test_cell_cache);
+  UNITY_END();
+}
+
+void loop() {}
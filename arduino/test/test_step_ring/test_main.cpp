@@ -0,0 +1,98 @@
+// Step ring laser delay and parking - run on the board with 'pio test'
+#include "renderer/buffers.h"
+#include <Arduino.h>
+#include <unity.h>
+
+static step_ring_buf_16_t ring;
+
+static const point_q12_4_t park_point(1000, 2000);
+
+void setUp() { ring.clear(); }
+void tearDown() {}
+
+// Pops everything, returning the last step
+static void drain(point_q12_4_t *point, bool *laser) {
+  while (ring.pop(point, laser)) {
+  }
+}
+
+// A lagging delay line still holds lit flags when the frame stops - the park
+// step must come out dark regardless
+void test_park_bypasses_delay() {
+  for (int8_t delay = 0; delay <= MAX_LASER_DELAY; delay++) {
+    ring.clear();
+    ring.set_laser_delay(delay);
+    for (uint8_t i = 0; i < 10; i++) {
+      TEST_ASSERT_TRUE(ring.push(point_q12_4_t(i, i), true));
+    }
+    ring.park(park_point);
+
+    point_q12_4_t point;
+    bool laser = true;
+    drain(&point, &laser);
+    TEST_ASSERT_TRUE(point == park_point);
+    TEST_ASSERT_FALSE(laser);
+  }
+}
+
+void test_park_leading_delay() {
+  ring.set_laser_delay(-3);
+  for (uint8_t i = 0; i < 10; i++) {
+    ring.push(point_q12_4_t(i, i), true);
+  }
+  ring.park(park_point);
+
+  point_q12_4_t point;
+  bool laser = true;
+  drain(&point, &laser);
+  TEST_ASSERT_TRUE(point == park_point);
+  TEST_ASSERT_FALSE(laser);
+}
+
+// With no room the newest step is blanked where it is
+void test_park_full_ring() {
+  ring.set_laser_delay(4);
+  uint8_t pushed = 0;
+  while (ring.push(point_q12_4_t(pushed, 0), true)) {
+    pushed++;
+  }
+  TEST_ASSERT_TRUE(ring.is_full());
+  ring.park(park_point);
+  TEST_ASSERT_EQUAL_UINT8(pushed, ring.size());
+
+  point_q12_4_t point;
+  bool laser = true;
+  drain(&point, &laser);
+  TEST_ASSERT_EQUAL_INT16(pushed - 1, point.x);
+  TEST_ASSERT_FALSE(laser);
+}
+
+// Steps after a park don't pick up lit flags from before it
+void test_park_clears_history() {
+  ring.set_laser_delay(3);
+  for (uint8_t i = 0; i < 5; i++) {
+    ring.push(point_q12_4_t(i, i), true);
+  }
+  ring.park(park_point);
+
+  point_q12_4_t point;
+  bool laser;
+  drain(&point, &laser);
+  for (uint8_t i = 0; i < 3; i++) {
+    ring.push(point_q12_4_t(i, i), false);
+    TEST_ASSERT_TRUE(ring.pop(&point, &laser));
+    TEST_ASSERT_FALSE(laser);
+  }
+}
+
+void setup() {
+  delay(2000); // Let the serial monitor attach
+  UNITY_BEGIN();
+  RUN_TEST(test_park_bypasses_delay);
+  RUN_TEST(test_park_leading_delay);
+  RUN_TEST(test_park_full_ring);
+  RUN_TEST(test_park_clears_history);
+  UNITY_END();
+}
+
+void loop() {}
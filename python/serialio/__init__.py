@@ -8,6 +8,12 @@ Main Components:
 - SerialConnection: Manages serial port connections
 - Commands: Command generation and formatting
 - Parser: Response parsing and validation
+- Trace: Decoder for the firmware's binary event trace
+- Wire: Compact encoder for frame uploads
+- Program: Assembler for display list programs
+- Sprites: Instance lists for the firmware's flash sprites
+- Text: Text runs for the firmware's flash stroke font
+- Generators: Parametric figures worked out by the firmware
 
 Usage:
     from serialio import SerialConnection, cmd_write, cmd_dump
@@ -22,8 +28,47 @@ from .commands import (
     cmd_clear,
     cmd_size,
     build_write_sequence_from_buffer,
+    cmd_frame_begin,
+    cmd_frame_begin_abs,
+    cmd_frame_begin_prog,
+    cmd_frame_begin_sprites,
+    cmd_frame_begin_text,
+    cmd_frame_begin_gen,
+    cmd_frame_point,
+    cmd_frame_commit,
+    cmd_frame_info,
+    build_frame_sequence,
+    cmd_xform,
+    cmd_grid,
+    build_grid_sequence,
+)
+from .parser import (
+    is_eoc,
+    accumulate_dump_lines,
+    parse_dump_text,
+    parse_frame_summary,
+)
+from .trace import TraceDecoder, TraceRecord
+from .wire import (
+    encode_points,
+    build_data_sequence,
+    build_frame_stream_sequence,
+    curve_points,
+    arc_points,
+)
+from .program import Program, run_program, build_program_sequence
+from .sprites import SpriteInstance, encode_instances, build_sprite_sequence
+from .text import TextRun, text_width, encode_runs, build_text_sequence
+from .generators import (
+    Generator,
+    lissajous,
+    spiral,
+    polygon,
+    grid,
+    ilda_pattern,
+    encode_generators,
+    build_generator_sequence,
 )
-from .parser import is_eoc, accumulate_dump_lines, parse_dump_text
 
 __all__ = [
     "SerialConnection",
@@ -34,9 +79,48 @@ __all__ = [
     "cmd_clear",
     "cmd_size",
     "build_write_sequence_from_buffer",
+    "cmd_frame_begin",
+    "cmd_frame_begin_abs",
+    "cmd_frame_begin_prog",
+    "cmd_frame_begin_sprites",
+    "cmd_frame_begin_text",
+    "cmd_frame_begin_gen",
+    "cmd_frame_point",
+    "cmd_frame_commit",
+    "cmd_frame_info",
+    "build_frame_sequence",
+    "cmd_xform",
+    "cmd_grid",
+    "build_grid_sequence",
     "is_eoc",
     "accumulate_dump_lines",
     "parse_dump_text",
+    "parse_frame_summary",
+    "TraceDecoder",
+    "TraceRecord",
+    "encode_points",
+    "build_data_sequence",
+    "build_frame_stream_sequence",
+    "curve_points",
+    "arc_points",
+    "Program",
+    "run_program",
+    "build_program_sequence",
+    "SpriteInstance",
+    "encode_instances",
+    "build_sprite_sequence",
+    "TextRun",
+    "text_width",
+    "encode_runs",
+    "build_text_sequence",
+    "Generator",
+    "lissajous",
+    "spiral",
+    "polygon",
+    "grid",
+    "ilda_pattern",
+    "encode_generators",
+    "build_generator_sequence",
 ]
 
 # Version information
@@ -68,3 +68,139 @@ def build_write_sequence_from_buffer(buffer_data) -> List[str]:
 
     cmds.append(cmd_size(n, INACTIVE))
     return cmds
+
+
+# Frame upload commands (firmware 'frame' command group). These are lowercase
+# subcommands of 'frame' and stage a whole frame in the point arena before it
+# is shown with 'frame commit'.
+#
+# 'frame begin' stores the frame delta-compressed, so points must be sent in
+# index order; 'frame begin_abs' uses 3 bytes per point and allows any order.
+# 'frame begin_prog' takes a display list program instead (see program.py),
+# 'frame begin_sprites' a list of flash sprite instances (see sprites.py),
+# 'frame begin_text' runs of text in the flash font (see text.py) and
+# 'frame begin_gen' parametric figures (see generators.py). 'frame begin_prog'
+# needs firmware built with ENABLE_PROGRAMS (arduino/src/config.h).
+def _check_count(count: int):
+    if not (1 <= int(count) <= 255):
+        raise ValueError(f"count must be 1..255, got {count}")
+
+
+def cmd_frame_begin(count: int) -> str:
+    _check_count(count)
+    return f"frame begin {int(count)}"
+
+
+def cmd_frame_begin_abs(count: int) -> str:
+    _check_count(count)
+    return f"frame begin_abs {int(count)}"
+
+
+def cmd_frame_begin_prog() -> str:
+    return "frame begin_prog"
+
+
+def cmd_frame_begin_sprites() -> str:
+    return "frame begin_sprites"
+
+
+def cmd_frame_begin_text() -> str:
+    return "frame begin_text"
+
+
+def cmd_frame_begin_gen() -> str:
+    return "frame begin_gen"
+
+
+def cmd_frame_point(idx: int, x: int, y: int, flags: int) -> str:
+    _check_uint8("index", idx)
+    _check_uint8("x", x)
+    _check_uint8("y", y)
+    _check_uint8("flags", flags)
+    return f"frame point {int(idx)} {int(x)} {int(y)} {int(flags)}"
+
+
+def cmd_frame_commit() -> str:
+    return "frame commit"
+
+
+def cmd_frame_info() -> str:
+    return "frame info"
+
+
+# Output transform - scale, rotation and offset applied by the firmware to
+# every point from the next frame, so motion effects don't need a re-upload.
+# See arduino/src/renderer/transform.h.
+XFORM_SCALE_ONE = 64  # Firmware scale units per 1.0
+XFORM_ANGLE_TURN = 256  # Firmware angle units per full turn
+
+
+def cmd_xform(
+    scale: float = 1.0, angle_deg: float = 0.0, dx: int = 0, dy: int = 0
+) -> str:
+    """scale 0..~4, angle in degrees (anticlockwise), dx/dy in 0..255 units."""
+    s = int(round(scale * XFORM_SCALE_ONE))
+    if not (0 <= s <= 255):
+        raise ValueError(
+            f"scale must be 0..{255 / XFORM_SCALE_ONE:.2f}, got {scale}"
+        )
+    a = int(round(angle_deg * XFORM_ANGLE_TURN / 360.0)) % XFORM_ANGLE_TURN
+    for name, v in (("dx", dx), ("dy", dy)):
+        if not (-128 <= int(v) <= 127):
+            raise ValueError(f"{name} must be -128..127, got {v}")
+    return f"xform {s} {a} {int(dx)} {int(dy)}"
+
+
+# Geometric correction grid (arduino/src/renderer/grid.h) - needs firmware
+# built with ENABLE_GRID (arduino/src/config.h)
+GRID_NODES = 5  # Nodes per axis, evenly spread over the DAC range
+GRID_MAX_OFFSET = 511  # DAC counts, either way
+
+
+def cmd_grid(col: int, row: int, dx: int, dy: int) -> str:
+    """Set the x/y offset of one correction grid node, in DAC counts."""
+    for name, v in (("col", col), ("row", row)):
+        if not (0 <= int(v) < GRID_NODES):
+            raise ValueError(f"{name} must be 0..{GRID_NODES - 1}, got {v}")
+    for name, v in (("dx", dx), ("dy", dy)):
+        if not (-GRID_MAX_OFFSET <= int(v) <= GRID_MAX_OFFSET):
+            raise ValueError(
+                f"{name} must be -{GRID_MAX_OFFSET}..{GRID_MAX_OFFSET}, got {v}"
+            )
+    return f"grid {int(col)} {int(row)} {int(dx)} {int(dy)}"
+
+
+def build_grid_sequence(offsets) -> List[str]:
+    """
+    Load a whole correction grid and turn it on.
+
+    offsets is GRID_NODES rows (bottom first) of GRID_NODES (dx, dy) pairs.
+    """
+    rows = list(offsets)
+    if len(rows) != GRID_NODES or any(len(r) != GRID_NODES for r in rows):
+        raise ValueError(f"grid must be {GRID_NODES}x{GRID_NODES} nodes")
+    cmds = [
+        cmd_grid(col, row, dx, dy)
+        for row, nodes in enumerate(rows)
+        for col, (dx, dy) in enumerate(nodes)
+    ]
+    cmds.append("set grid_correction 1")
+    return cmds
+
+
+def build_frame_sequence(points: Iterable) -> List[str]:
+    """
+    Build a 'frame begin -> frame point* -> frame commit' sequence.
+
+    points is an iterable of (x, y, flags) tuples or objects with .x, .y and
+    .flags (e.g. the steps of a BufferData).
+    """
+    pts = list(points)
+    cmds: List[str] = [cmd_frame_begin(len(pts))]
+
+    for i, p in enumerate(pts):
+        x, y, flags = (p.x, p.y, p.flags) if hasattr(p, "x") else p
+        cmds.append(cmd_frame_point(i, x, y, flags))
+
+    cmds.append(cmd_frame_commit())
+    return cmds
@@ -0,0 +1,146 @@
+"""
+Parametric figures worked out by the firmware ('frame begin_gen', see
+arduino/src/renderer/generator.h).
+
+Each figure is 11 bytes however many points it draws, so calibration
+patterns and simple effects need no point streaming, and a fixed figure
+gives the output path the same load every pass:
+
+    figures = [
+        lissajous(3, 2, points=120, loops=8, drift=4),
+        polygon(6, rx=40, ry=40),
+    ]
+    for line in build_generator_sequence(figures):
+        connection.send(line)
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass
+from typing import Iterable, List
+
+from .commands import cmd_frame_begin_gen
+from .wire import MAX_CHUNK_BYTES, build_data_sequence
+
+# Figure kinds (generator_kind_t)
+GENERATOR_LISSAJOUS = 0
+GENERATOR_SPIRAL = 1
+GENERATOR_POLYGON = 2
+GENERATOR_GRID = 3
+GENERATOR_TEST = 4
+
+ANGLE_TURN = 256  # Firmware angle units per full turn
+GENERATOR_BYTES = 11
+TEST_PATTERN_POINTS = 17
+MAX_PASS_POINTS = 1024  # Firmware limit on the figures of one frame
+
+
+@dataclass
+class Generator:
+    kind: int
+    x: int = 128
+    y: int = 128
+    rx: int = 120
+    ry: int = 120
+    points: int = 0
+    loops: int = 1
+    a: int = 0
+    b: int = 0
+    angle: int = 0
+    drift: int = 0
+
+    def loop_points(self) -> int:
+        """Points the firmware outputs per loop."""
+        if self.kind in (GENERATOR_LISSAJOUS, GENERATOR_SPIRAL):
+            return self.points + 1
+        if self.kind == GENERATOR_POLYGON:
+            return self.a + 1
+        if self.kind == GENERATOR_GRID:
+            return 2 * (self.a + self.b)
+        return TEST_PATTERN_POINTS
+
+    def point_count(self) -> int:
+        """Points one pass of the figure outputs."""
+        return self.loop_points() * max(int(self.loops), 1)
+
+    def encode(self) -> bytes:
+        for name in ("kind", "x", "y", "rx", "ry", "points", "loops", "a", "b"):
+            v = getattr(self, name)
+            if not (0 <= int(v) <= 255):
+                raise ValueError(f"{name} must be 0..255, got {v}")
+        if self.kind not in (
+            GENERATOR_LISSAJOUS,
+            GENERATOR_SPIRAL,
+            GENERATOR_POLYGON,
+            GENERATOR_GRID,
+            GENERATOR_TEST,
+        ):
+            raise ValueError(f"bad kind {self.kind}")
+        phased = self.kind in (GENERATOR_LISSAJOUS, GENERATOR_SPIRAL)
+        if phased and self.points < 1:
+            raise ValueError("points must be at least 1")
+        if self.kind == GENERATOR_POLYGON and self.a < 2:
+            raise ValueError("a polygon needs at least 2 sides")
+        if self.kind == GENERATOR_GRID and self.a + self.b < 1:
+            raise ValueError("a grid needs at least one line")
+        return bytes(
+            [
+                int(self.kind),
+                int(self.x),
+                int(self.y),
+                int(self.rx),
+                int(self.ry),
+                int(self.points),
+                int(self.loops),
+                int(self.a),
+                int(self.b),
+                int(self.angle) % ANGLE_TURN,
+                int(self.drift) % ANGLE_TURN,
+            ]
+        )
+
+
+def lissajous(
+    a: int, b: int, points: int = 100, phase: int = 64, drift: int = 0, **kw
+) -> Generator:
+    """x = sin(a t), y = sin(b t + phase), drifting by drift every loop."""
+    return Generator(
+        GENERATOR_LISSAJOUS, points=points, a=a, b=b, angle=phase, drift=drift, **kw
+    )
+
+
+def spiral(turns: int, points: int = 100, **kw) -> Generator:
+    return Generator(GENERATOR_SPIRAL, points=points, a=turns, **kw)
+
+
+def polygon(sides: int, step: int = 1, **kw) -> Generator:
+    """Regular polygon, or a star joining every step'th vertex."""
+    return Generator(GENERATOR_POLYGON, a=sides, b=step, **kw)
+
+
+def grid(columns: int, rows: int, **kw) -> Generator:
+    return Generator(GENERATOR_GRID, a=columns, b=rows, **kw)
+
+
+def ilda_pattern(**kw) -> Generator:
+    return Generator(GENERATOR_TEST, **kw)
+
+
+def encode_generators(figures: Iterable[Generator]) -> bytes:
+    figures = list(figures)
+    total = sum(fig.point_count() for fig in figures)
+    if total > MAX_PASS_POINTS:
+        raise ValueError(
+            f"figures add up to {total} points, over {MAX_PASS_POINTS}"
+        )
+    return b"".join(fig.encode() for fig in figures)
+
+
+def build_generator_sequence(
+    figures: Iterable[Generator], chunk_bytes: int = MAX_CHUNK_BYTES
+) -> List[str]:
+    """Build a 'frame begin_gen -> frame data* -> frame commit' upload."""
+    data = encode_generators(figures)
+    if not data:
+        raise ValueError("no figures")
+    return build_data_sequence(cmd_frame_begin_gen(), data, chunk_bytes)
@@ -1,6 +1,6 @@
 from __future__ import annotations
 
-from typing import Iterable, List
+from typing import Dict, Iterable, List, Optional
 
 # We delegate actual DUMP parsing to your BufferData model,
 # per your progress report design.
@@ -29,3 +29,35 @@ def parse_dump_text(text: str) -> BufferData:
     Create BufferData from DUMP text (no EOC line).
     """
     return BufferData.from_dump_response(text)
+
+
+def parse_frame_summary(line: str) -> Optional[Dict[str, int]]:
+    """
+    Parse the frame summary the firmware prints after 'frame commit':
+
+        OK steps=812 frame_us=81200 blank_pct=12 table=1
+
+    Generated frames (programs, sprites, text, generators) are summed up as
+    they are drawn, so their commit reports 0s - 'frame info' prints the
+    summary once the frame has been drawn through.
+
+    Firmware built without ENABLE_FRAME_SUMMARY replies a bare "OK".
+
+    Returns a dict of the key=value fields as ints, or None if the line is
+    not a frame summary (e.g. an ERR line or a bare OK).
+    """
+    text = line.strip()
+    if text.startswith("OK"):
+        text = text[2:]
+    fields: Dict[str, int] = {}
+    for token in text.split():
+        key, sep, value = token.partition("=")
+        if not sep:
+            return None
+        try:
+            fields[key] = int(value)
+        except ValueError:
+            return None
+    if "steps" not in fields:
+        return None
+    return fields
@@ -0,0 +1,266 @@
+"""
+Assembler for display list programs ('frame begin_prog', see
+arduino/src/renderer/program.h). The firmware only takes them when built with
+ENABLE_PROGRAMS.
+
+A program is bytecode the firmware runs each pass to produce the frame's
+points, so repeated shapes cost a loop or a subroutine call instead of a
+copy of every point:
+
+    prog = Program()
+    prog.repeat(4)
+    prog.push().call("box").pop().translate(60, 0)
+    prog.next()
+    prog.end()
+    prog.label("box")
+    prog.move(10, 10).line_rel(40, 0).line_rel(0, 40)
+    prog.line_rel(-40, 0).line_rel(0, -40).ret()
+
+    for line in build_program_sequence(prog.assemble()):
+        connection.send(line)
+"""
+
+from __future__ import annotations
+
+from typing import Dict, List, Tuple, Union
+
+from .commands import cmd_frame_begin_prog
+from .wire import FLAG_BLANK, MAX_CHUNK_BYTES, build_data_sequence
+
+OP_END = 0x00
+OP_MOVE = 0x01
+OP_LINE = 0x02
+OP_MOVE_REL = 0x03
+OP_LINE_REL = 0x04
+OP_POINT = 0x05
+OP_BLANK = 0x06
+OP_REPEAT = 0x07
+OP_NEXT = 0x08
+OP_CALL = 0x09
+OP_RET = 0x0A
+OP_PUSH = 0x0B
+OP_POP = 0x0C
+OP_TRANSLATE = 0x0D
+
+# Instruction length in bytes, opcode included
+OP_SIZE = {
+    OP_END: 1,
+    OP_MOVE: 3,
+    OP_LINE: 3,
+    OP_MOVE_REL: 3,
+    OP_LINE_REL: 3,
+    OP_POINT: 4,
+    OP_BLANK: 2,
+    OP_REPEAT: 2,
+    OP_NEXT: 1,
+    OP_CALL: 3,
+    OP_RET: 1,
+    OP_PUSH: 1,
+    OP_POP: 1,
+    OP_TRANSLATE: 3,
+}
+
+# Firmware limits (program.h)
+STACK_DEPTH = 4
+MAX_PASS_POINTS = 1024
+MAX_IDLE_OPS = 1024
+MAX_PASS_OPS = 8192
+
+Point = Tuple[int, int, int]
+
+
+def _u8(name: str, v: int) -> int:
+    if not (0 <= int(v) <= 255):
+        raise ValueError(f"{name} must be 0..255, got {v}")
+    return int(v)
+
+
+def _s8(name: str, v: int) -> int:
+    if not (-128 <= int(v) <= 127):
+        raise ValueError(f"{name} must be -128..127, got {v}")
+    return int(v) & 0xFF
+
+
+class Program:
+    """Builds a program one instruction at a time. Methods chain."""
+
+    def __init__(self):
+        self._code = bytearray()
+        self._labels: Dict[str, int] = {}
+        self._fixups: List[Tuple[int, str]] = []
+
+    def _emit(self, *data: int) -> "Program":
+        self._code.extend(data)
+        return self
+
+    def move(self, x: int, y: int) -> "Program":
+        return self._emit(OP_MOVE, _u8("x", x), _u8("y", y))
+
+    def line(self, x: int, y: int) -> "Program":
+        return self._emit(OP_LINE, _u8("x", x), _u8("y", y))
+
+    def move_rel(self, dx: int, dy: int) -> "Program":
+        return self._emit(OP_MOVE_REL, _s8("dx", dx), _s8("dy", dy))
+
+    def line_rel(self, dx: int, dy: int) -> "Program":
+        return self._emit(OP_LINE_REL, _s8("dx", dx), _s8("dy", dy))
+
+    def point(self, x: int, y: int, flags: int) -> "Program":
+        return self._emit(OP_POINT, _u8("x", x), _u8("y", y), _u8("flags", flags))
+
+    def blank(self, on: bool = True) -> "Program":
+        return self._emit(OP_BLANK, 1 if on else 0)
+
+    def repeat(self, count: int) -> "Program":
+        if not (1 <= int(count) <= 255):
+            raise ValueError(f"count must be 1..255, got {count}")
+        return self._emit(OP_REPEAT, int(count))
+
+    def next(self) -> "Program":
+        return self._emit(OP_NEXT)
+
+    def label(self, name: str) -> "Program":
+        if name in self._labels:
+            raise ValueError(f"label {name!r} defined twice")
+        self._labels[name] = len(self._code)
+        return self
+
+    def call(self, target: Union[str, int]) -> "Program":
+        if isinstance(target, str):
+            self._fixups.append((len(self._code) + 1, target))
+            target = 0
+        if not (0 <= int(target) <= 0xFFFF):
+            raise ValueError(f"call target must be 0..65535, got {target}")
+        return self._emit(OP_CALL, int(target) & 0xFF, int(target) >> 8)
+
+    def ret(self) -> "Program":
+        return self._emit(OP_RET)
+
+    def push(self) -> "Program":
+        return self._emit(OP_PUSH)
+
+    def pop(self) -> "Program":
+        return self._emit(OP_POP)
+
+    def translate(self, dx: int, dy: int) -> "Program":
+        return self._emit(OP_TRANSLATE, _s8("dx", dx), _s8("dy", dy))
+
+    def end(self) -> "Program":
+        return self._emit(OP_END)
+
+    def assemble(self) -> bytes:
+        """The bytecode, with call labels filled in."""
+        code = bytearray(self._code)
+        for pos, name in self._fixups:
+            if name not in self._labels:
+                raise ValueError(f"undefined label {name!r}")
+            addr = self._labels[name]
+            code[pos] = addr & 0xFF
+            code[pos + 1] = addr >> 8
+        return bytes(code)
+
+
+def run_program(code: bytes) -> List[Point]:
+    """
+    One pass of a program, as the firmware runs it - for previews and tests.
+    Raises ValueError where the firmware would reject the program.
+    """
+    pc = 0
+    x = y = 0
+    ox = oy = 0
+    blank = False
+    stack: List[Tuple[int, int, int]] = []  # (op, count, value)
+    points: List[Point] = []
+    idle = 0
+    ops = 0
+
+    def push(op: int, count: int, value: int):
+        if len(stack) >= STACK_DEPTH:
+            raise ValueError(f"stack overflow at {pc}")
+        stack.append((op, count, value))
+
+    def top(op: int):
+        if not stack or stack[-1][0] != op:
+            raise ValueError(f"unmatched instruction at {pc}")
+        return stack[-1]
+
+    while len(points) < MAX_PASS_POINTS and pc < len(code):
+        ops += 1
+        if ops > MAX_PASS_OPS:
+            raise ValueError("program runs too long")
+        op = code[pc]
+        if op not in OP_SIZE:
+            raise ValueError(f"bad opcode {op:#04x} at {pc}")
+        size = OP_SIZE[op]
+        if pc + size > len(code):
+            raise ValueError(f"truncated instruction at {pc}")
+        arg = code[pc + 1 : pc + size]
+        pc += size
+
+        out = None
+        if op == OP_END:
+            break
+        elif op == OP_MOVE:
+            out = (arg[0], arg[1], FLAG_BLANK)
+        elif op == OP_LINE:
+            out = (arg[0], arg[1], FLAG_BLANK if blank else 0)
+        elif op in (OP_MOVE_REL, OP_LINE_REL):
+            dx = arg[0] - 256 if arg[0] >= 128 else arg[0]
+            dy = arg[1] - 256 if arg[1] >= 128 else arg[1]
+            lit = op == OP_LINE_REL and not blank
+            out = ((x + dx) & 0xFF, (y + dy) & 0xFF, 0 if lit else FLAG_BLANK)
+        elif op == OP_POINT:
+            out = (arg[0], arg[1], arg[2])
+        elif op == OP_BLANK:
+            blank = bool(arg[0])
+        elif op == OP_REPEAT:
+            if arg[0] == 0:
+                raise ValueError(f"REPEAT 0 at {pc - size}")
+            push(OP_REPEAT, arg[0], pc)
+        elif op == OP_NEXT:
+            _, count, start = top(OP_REPEAT)
+            if count > 1:
+                stack[-1] = (OP_REPEAT, count - 1, start)
+                pc = start
+            else:
+                stack.pop()
+        elif op == OP_CALL:
+            push(OP_CALL, 0, pc)
+            pc = arg[0] | arg[1] << 8
+            if pc >= len(code):
+                raise ValueError(f"call outside the program at {pc}")
+        elif op == OP_RET:
+            pc = top(OP_CALL)[2]
+            stack.pop()
+        elif op == OP_PUSH:
+            push(OP_PUSH, 0, ox | oy << 8)
+        elif op == OP_POP:
+            value = top(OP_PUSH)[2]
+            stack.pop()
+            ox, oy = value & 0xFF, value >> 8
+        elif op == OP_TRANSLATE:
+            ox = (ox + arg[0]) & 0xFF
+            oy = (oy + arg[1]) & 0xFF
+
+        if out is None:
+            idle += 1
+            if idle >= MAX_IDLE_OPS:
+                raise ValueError("program loops without output")
+            continue
+
+        idle = 0
+        x, y = out[0], out[1]
+        points.append(((x + ox) & 0xFF, (y + oy) & 0xFF, out[2] & 0x7F))
+
+    if not points:
+        raise ValueError("program outputs no points")
+    return points
+
+
+def build_program_sequence(
+    code: bytes, chunk_bytes: int = MAX_CHUNK_BYTES
+) -> List[str]:
+    """Build a 'frame begin_prog -> frame data* -> frame commit' upload."""
+    if not code:
+        raise ValueError("empty program")
+    return build_data_sequence(cmd_frame_begin_prog(), code, chunk_bytes)
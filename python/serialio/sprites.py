@@ -0,0 +1,81 @@
+"""
+Instance lists for the firmware's flash sprites ('frame begin_sprites', see
+arduino/src/renderer/sprite.h).
+
+The sprite outlines are built into the firmware, so a frame is only 6 bytes
+per instance however many points the sprites have:
+
+    instances = [
+        SpriteInstance(SPRITE_STAR, 64, 64),
+        SpriteInstance(SPRITE_CIRCLE, 180, 128, scale=96, policy=POLICY_CONNECT),
+    ]
+    for line in build_sprite_sequence(instances):
+        connection.send(line)
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass
+from typing import Iterable, List
+
+from .commands import cmd_frame_begin_sprites
+from .wire import MAX_CHUNK_BYTES, build_data_sequence
+
+# Built in sprites (sprite_id_t), +/-32 around their origin at scale 1:1
+SPRITE_SQUARE = 0
+SPRITE_TRIANGLE = 1
+SPRITE_CIRCLE = 2
+SPRITE_STAR = 3
+SPRITE_ARROW = 4
+SPRITE_CROSS = 5
+
+# How an instance is reached from the point before it (sprite_policy_t)
+POLICY_JUMP = 0  # Blanked move to its first point
+POLICY_CONNECT = 1  # Drawn from the previous point
+POLICY_HIDDEN = 2  # Not drawn
+
+SCALE_ONE = 64  # Firmware scale units per 1.0
+ANGLE_TURN = 256  # Firmware angle units per full turn
+INSTANCE_BYTES = 6
+
+
+@dataclass
+class SpriteInstance:
+    sprite: int
+    x: int
+    y: int
+    scale: int = SCALE_ONE
+    angle: int = 0
+    policy: int = POLICY_JUMP
+
+    def encode(self) -> bytes:
+        for name in ("sprite", "x", "y", "scale"):
+            v = getattr(self, name)
+            if not (0 <= int(v) <= 255):
+                raise ValueError(f"{name} must be 0..255, got {v}")
+        if self.policy not in (POLICY_JUMP, POLICY_CONNECT, POLICY_HIDDEN):
+            raise ValueError(f"bad policy {self.policy}")
+        return bytes(
+            [
+                int(self.sprite),
+                int(self.x),
+                int(self.y),
+                int(self.scale),
+                int(self.angle) % ANGLE_TURN,
+                int(self.policy),
+            ]
+        )
+
+
+def encode_instances(instances: Iterable[SpriteInstance]) -> bytes:
+    return b"".join(inst.encode() for inst in instances)
+
+
+def build_sprite_sequence(
+    instances: Iterable[SpriteInstance], chunk_bytes: int = MAX_CHUNK_BYTES
+) -> List[str]:
+    """Build a 'frame begin_sprites -> frame data* -> frame commit' upload."""
+    data = encode_instances(instances)
+    if not data:
+        raise ValueError("no sprite instances")
+    return build_data_sequence(cmd_frame_begin_sprites(), data, chunk_bytes)
@@ -0,0 +1,105 @@
+"""
+Text runs for the firmware's stroke font ('frame begin_text', see
+arduino/src/renderer/text.h and font.h).
+
+The font is built into the firmware, so a frame only carries a 6 byte header
+and the characters of each run. Scrolling text costs the same few bytes per
+frame, with only x changing:
+
+    width = text_width("HELLO", size=32)
+    for x in range(255, -width, -2):
+        for line in build_text_sequence([TextRun("HELLO", x, 100, size=32)]):
+            connection.send(line)
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass
+from typing import Iterable, List
+
+from .commands import cmd_frame_begin_text
+from .wire import MAX_CHUNK_BYTES, build_data_sequence
+
+SIZE_ONE = 16  # Firmware size for one coord8 per font unit
+CAP_HEIGHT = 21  # Font units
+ASCENT = 25
+DESCENT = -7
+RUN_HEADER_BYTES = 6
+MAX_RUN_CHARS = 255
+FIRST_CHAR = 32
+LAST_CHAR = 126
+
+# Advance of each glyph in font units, FIRST_CHAR..LAST_CHAR (Hershey Simplex)
+HERSHEY_WIDTHS = [
+    16, 10, 16, 21, 20, 24, 26, 10, 14, 14, 16, 26, 10, 26, 10, 22,
+    20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 10, 10, 24, 26, 24, 18,
+    27, 18, 21, 21, 21, 19, 18, 21, 22, 8, 16, 21, 17, 24, 22, 22,
+    21, 22, 21, 20, 16, 22, 18, 24, 20, 18, 20, 14, 14, 14, 16, 16,
+    10, 19, 19, 18, 19, 18, 12, 19, 19, 8, 10, 17, 8, 30, 19, 19,
+    19, 19, 13, 17, 12, 19, 16, 22, 17, 16, 17, 14, 8, 14, 24,]
+
+
+def _scale(units: int, size: int) -> int:
+    # Same rounding as the firmware (arithmetic shift)
+    return (units * size + SIZE_ONE // 2) >> 4
+
+
+def _char_code(c: str) -> int:
+    code = ord(c)
+    return code if FIRST_CHAR <= code <= LAST_CHAR else ord("?")
+
+
+def text_width(text: str, size: int = SIZE_ONE, spacing: int = 0) -> int:
+    """Advance of text in coord8, as the firmware steps it."""
+    return sum(
+        _scale(HERSHEY_WIDTHS[_char_code(c) - FIRST_CHAR], size) + spacing
+        for c in text
+    )
+
+
+@dataclass
+class TextRun:
+    text: str
+    x: int  # Left end of the baseline, may be off the field
+    y: int
+    size: int = SIZE_ONE
+    spacing: int = 0
+
+    def encode(self) -> bytes:
+        if not (-32768 <= int(self.x) <= 32767):
+            raise ValueError(f"x must be -32768..32767, got {self.x}")
+        for name in ("y", "size"):
+            v = getattr(self, name)
+            if not (0 <= int(v) <= 255):
+                raise ValueError(f"{name} must be 0..255, got {v}")
+        if not (-128 <= int(self.spacing) <= 127):
+            raise ValueError(f"spacing must be -128..127, got {self.spacing}")
+        if len(self.text) > MAX_RUN_CHARS:
+            raise ValueError(f"at most {MAX_RUN_CHARS} characters per run")
+        x = int(self.x) & 0xFFFF
+        return bytes(
+            [
+                x & 0xFF,
+                x >> 8,
+                int(self.y),
+                int(self.size),
+                int(self.spacing) & 0xFF,
+                len(self.text),
+            ]
+        ) + bytes(_char_code(c) for c in self.text)
+
+
+def encode_runs(runs: Iterable[TextRun]) -> bytes:
+    return b"".join(run.encode() for run in runs)
+
+
+def build_text_sequence(
+    runs: Iterable[TextRun], chunk_bytes: int = MAX_CHUNK_BYTES
+) -> List[str]:
+    """Build a 'frame begin_text -> frame data* -> frame commit' upload.
+
+    The firmware refuses the commit if no glyph is on the field."""
+    data = encode_runs(runs)
+    if not data:
+        raise ValueError("no text runs")
+    return build_data_sequence(cmd_frame_begin_text(), data, chunk_bytes)
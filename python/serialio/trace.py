@@ -0,0 +1,183 @@
+"""
+Decoder for the firmware's binary event trace (arduino/src/diagnostics/trace.h).
+
+The firmware streams 8 byte frames on the same serial port as its text output:
+
+    0xA5, ts_lo, ts_hi, id, a, b_lo, b_hi, checksum
+
+where checksum is the low byte of the sum of the six payload bytes and the
+timestamp is a 16 bit count of 4us clock ticks. TraceDecoder pulls frames out
+of a raw byte stream, passes any other bytes through as text, and unwraps the
+16 bit timestamps into a monotonic microsecond clock.
+
+Usage:
+    decoder = TraceDecoder()
+    for record in decoder.feed(port.read(port.in_waiting)):
+        print(record)
+    text = decoder.take_text()
+
+    python -m serialio.trace capture.bin
+"""
+
+from __future__ import annotations
+
+import sys
+from dataclasses import dataclass
+from typing import Dict, List
+
+SYNC_BYTE = 0xA5
+FRAME_SIZE = 8
+TICK_US = 4  # Timer0 at /64 on a 16MHz part
+TIMESTAMP_WRAP = 1 << 16
+
+# Keep in sync with trace_event_t in arduino/src/diagnostics/trace.h
+TRACE_EVENTS: Dict[int, str] = {
+    0: "OVERFLOW",
+    1: "STEP_POP",
+    2: "STEP_PUSH",
+    3: "STEP_UNDERRUN",
+    4: "TRANSITION",
+    5: "INTERP_INIT",
+    6: "DWELL",
+    7: "BUFFER_END",
+    8: "BUFFER_SWAP",
+    9: "RENDER_FAULT",
+    10: "REPLAY",
+    15: "USER",
+}
+
+
+def event_mask(*names: str) -> int:
+    """Build a value for the firmware's 'trace mask' command from event names."""
+    ids = {name: event_id for event_id, name in TRACE_EVENTS.items()}
+    mask = 0
+    for name in names:
+        key = name.upper()
+        if key not in ids:
+            raise ValueError(f"unknown trace event {name!r}")
+        mask |= 1 << ids[key]
+    return mask
+
+
+@dataclass(frozen=True)
+class TraceRecord:
+    timestamp: int  # raw 16 bit tick count as sent by the device
+    event: int
+    a: int
+    b: int
+    time_us: int = 0  # unwrapped time since the first decoded record
+
+    @property
+    def name(self) -> str:
+        return TRACE_EVENTS.get(self.event, f"EVENT_{self.event}")
+
+    def __str__(self) -> str:
+        return f"{self.time_us:>10}us {self.name:<14} a={self.a:<3} b={self.b}"
+
+
+def _checksum(payload: bytes) -> int:
+    return sum(payload) & 0xFF
+
+
+def encode_frame(timestamp: int, event: int, a: int, b: int) -> bytes:
+    """Build a wire frame exactly as the firmware does (used by tests/tools)."""
+    payload = bytes(
+        [
+            timestamp & 0xFF,
+            (timestamp >> 8) & 0xFF,
+            event & 0xFF,
+            a & 0xFF,
+            b & 0xFF,
+            (b >> 8) & 0xFF,
+        ]
+    )
+    return bytes([SYNC_BYTE]) + payload + bytes([_checksum(payload)])
+
+
+class TraceDecoder:
+    """
+    Streaming decoder - feed it whatever the serial port returns.
+
+    Frames that fail the checksum are treated as text, one byte at a time,
+    so the decoder resynchronises on the next sync byte. Timestamps are
+    unwrapped assuming consecutive records are less than ~262ms apart.
+    """
+
+    def __init__(self):
+        self._buf = bytearray()
+        self._text = bytearray()
+        self._last_ts = None
+        self._elapsed_ticks = 0
+        self.frames_ok = 0
+        self.frames_bad = 0
+
+    def feed(self, data: bytes) -> List[TraceRecord]:
+        self._buf.extend(data)
+        records: List[TraceRecord] = []
+
+        while self._buf:
+            sync = self._buf.find(SYNC_BYTE)
+            if sync < 0:
+                self._text.extend(self._buf)
+                self._buf.clear()
+                break
+            if sync > 0:
+                self._text.extend(self._buf[:sync])
+                del self._buf[:sync]
+
+            if len(self._buf) < FRAME_SIZE:
+                break  # wait for the rest of the frame
+
+            payload = bytes(self._buf[1 : FRAME_SIZE - 1])
+            if _checksum(payload) != self._buf[FRAME_SIZE - 1]:
+                self.frames_bad += 1
+                self._text.append(self._buf[0])
+                del self._buf[:1]
+                continue
+
+            del self._buf[:FRAME_SIZE]
+            self.frames_ok += 1
+            records.append(self._make_record(payload))
+
+        return records
+
+    def take_text(self) -> str:
+        """Return and clear the non-trace bytes seen so far."""
+        text = self._text.decode("ascii", errors="replace")
+        self._text.clear()
+        return text
+
+    def _make_record(self, payload: bytes) -> TraceRecord:
+        timestamp = payload[0] | (payload[1] << 8)
+        if self._last_ts is not None:
+            self._elapsed_ticks += (timestamp - self._last_ts) % TIMESTAMP_WRAP
+        self._last_ts = timestamp
+
+        return TraceRecord(
+            timestamp=timestamp,
+            event=payload[2],
+            a=payload[3],
+            b=payload[4] | (payload[5] << 8),
+            time_us=self._elapsed_ticks * TICK_US,
+        )
+
+
+def main(argv: List[str]) -> int:
+    if len(argv) != 2:
+        print("usage: python -m serialio.trace CAPTURE_FILE", file=sys.stderr)
+        return 2
+
+    decoder = TraceDecoder()
+    with open(argv[1], "rb") as f:
+        for record in decoder.feed(f.read()):
+            print(record)
+
+    print(
+        f"# {decoder.frames_ok} records, {decoder.frames_bad} bad frames",
+        file=sys.stderr,
+    )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,250 @@
+"""
+Encoder for the firmware's frame wire format ('frame data', see
+arduino/src/comm/wire_decoder.h).
+
+The first point is sent absolute as x, y, flags. Every following point is a
+record of zigzag varint deltas, and runs of the previous point repeated
+(blanked dwell points, typically) collapse to a single varint:
+
+    varint(zz(dx) << 2 | 0) varint(zz(dy))          point, same flags
+    varint(zz(dx) << 2 | 1) varint(zz(dy)) flags    point, new flags
+    varint(count << 2 | 2)                          previous point repeated
+
+Deltas wrap modulo 256, so every delta fits in at most two varint bytes.
+The bytes are sent as hex in chunks small enough for the firmware's command
+line buffer.
+
+Usage:
+    for line in build_frame_stream_sequence(points):
+        connection.send(line)
+"""
+
+from __future__ import annotations
+
+import math
+from typing import Iterable, List, Sequence, Tuple
+
+from .commands import cmd_frame_begin, cmd_frame_commit
+
+KIND_POINT = 0
+KIND_POINT_FLAGS = 1
+KIND_REPEAT = 2
+MAX_RUN = 255
+VARINT_MAX_BYTES = 2
+
+# Point flag bits (arduino/src/types.h)
+FLAG_BLANK = 0x40
+FLAG_CURVE_CONTROL = 0x01  # Bezier control point of the next segment
+FLAG_ARC_CENTRE = 0x02  # Centre of an arc into the next point
+FLAG_ARC_CLOCKWISE = 0x04  # With FLAG_ARC_CENTRE
+
+# "frame data " plus two hex digits per byte must fit SERIAL_CMD_BUFFER_SIZE
+# (64) in arduino/src/config.h
+MAX_CHUNK_BYTES = 24
+
+Point = Tuple[int, int, int]
+
+
+def zigzag(v: int) -> int:
+    """Map a signed 8 bit delta to 0..255: 0, -1, 1, -2 ... -> 0, 1, 2, 3 ..."""
+    return (v << 1) ^ (v >> 7)
+
+
+def unzigzag(v: int) -> int:
+    return (v >> 1) ^ -(v & 1)
+
+
+def _wrap_delta(a: int, b: int) -> int:
+    """Signed 8 bit difference b - a, wrapping modulo 256 like the firmware."""
+    d = (b - a) & 0xFF
+    return d - 256 if d >= 128 else d
+
+
+def encode_varint(v: int) -> bytes:
+    out = bytearray()
+    while True:
+        byte = v & 0x7F
+        v >>= 7
+        if v:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def _as_point(p) -> Point:
+    x, y, flags = (p.x, p.y, p.flags) if hasattr(p, "x") else p
+    for name, v in (("x", x), ("y", y), ("flags", flags)):
+        if not (0 <= int(v) <= 255):
+            raise ValueError(f"{name} must be 0..255, got {v}")
+    return int(x), int(y), int(flags)
+
+
+def encode_points(points: Iterable) -> bytes:
+    """Encode (x, y, flags) tuples or objects with .x/.y/.flags."""
+    pts = [_as_point(p) for p in points]
+    if not pts:
+        return b""
+
+    out = bytearray(pts[0])
+    prev = pts[0]
+    i = 1
+    while i < len(pts):
+        p = pts[i]
+        if p == prev:
+            run = 1
+            while (
+                run < MAX_RUN and i + run < len(pts) and pts[i + run] == prev
+            ):
+                run += 1
+            out += encode_varint(run << 2 | KIND_REPEAT)
+            i += run
+            continue
+
+        dx = zigzag(_wrap_delta(prev[0], p[0]))
+        dy = zigzag(_wrap_delta(prev[1], p[1]))
+        if p[2] == prev[2]:
+            out += encode_varint(dx << 2 | KIND_POINT) + encode_varint(dy)
+        else:
+            out += encode_varint(dx << 2 | KIND_POINT_FLAGS)
+            out += encode_varint(dy) + bytes([p[2]])
+        prev = p
+        i += 1
+
+    return bytes(out)
+
+
+def decode_points(data: bytes) -> List[Point]:
+    """Reference decoder - mirrors WireDecoder in the firmware."""
+    if len(data) < 3:
+        raise ValueError("stream shorter than the first point")
+
+    pos = 3
+    x, y, flags = data[0], data[1], data[2]
+    points: List[Point] = [(x, y, flags)]
+
+    def read_varint() -> int:
+        nonlocal pos
+        v = 0
+        for n in range(VARINT_MAX_BYTES):
+            if pos >= len(data):
+                raise ValueError("truncated varint")
+            byte = data[pos]
+            pos += 1
+            v |= (byte & 0x7F) << (7 * n)
+            if not byte & 0x80:
+                return v
+        raise ValueError("varint too long")
+
+    while pos < len(data):
+        head = read_varint()
+        kind = head & 0x03
+        if kind == KIND_REPEAT:
+            run = head >> 2
+            if not 1 <= run <= MAX_RUN:
+                raise ValueError(f"bad run length {run}")
+            points.extend([(x, y, flags)] * run)
+            continue
+        if kind not in (KIND_POINT, KIND_POINT_FLAGS):
+            raise ValueError(f"bad record kind {kind}")
+
+        x = (x + unzigzag(head >> 2)) & 0xFF
+        y = (y + unzigzag(read_varint())) & 0xFF
+        if kind == KIND_POINT_FLAGS:
+            if pos >= len(data):
+                raise ValueError("truncated flags")
+            flags = data[pos]
+            pos += 1
+        points.append((x, y, flags))
+
+    return points
+
+
+def curve_points(controls: Sequence, end, flags: int = 0) -> List[Point]:
+    """
+    Points for a curved segment from the previous point to end - one (x, y)
+    control point for a quadratic Bezier, two for a cubic. The firmware draws
+    the curve itself (arduino/src/renderer/curve.h).
+    """
+    controls = list(controls)
+    if not 1 <= len(controls) <= 2:
+        raise ValueError(f"need 1 or 2 control points, got {len(controls)}")
+    points = [
+        _as_point((x, y, flags | FLAG_CURVE_CONTROL)) for x, y in controls
+    ]
+    points.append(_as_point((end[0], end[1], flags)))
+    return points
+
+
+def arc_points(
+    centre, radius: float, start: float, sweep: float, flags: int = 0
+) -> List[Point]:
+    """
+    Points for a circular arc - the start point, the arc centre and the end
+    point. Angles are in degrees, counterclockwise from +x; a negative sweep
+    runs clockwise and 360 or more is a full circle. The firmware draws the
+    arc itself (arduino/src/renderer/curve.h). A sweep too small to survive
+    rounding would read as a full circle there, so it becomes a point or a
+    line instead.
+    """
+    if sweep == 0:
+        raise ValueError("sweep must not be 0")
+    cx, cy = centre
+
+    def on_circle(angle):
+        a = math.radians(angle)
+        return (
+            round(cx + radius * math.cos(a)),
+            round(cy + radius * math.sin(a)),
+        )
+
+    first = on_circle(start)
+    last = first if abs(sweep) >= 360 else on_circle(start + sweep)
+    if abs(sweep) < 360:
+        # The firmware's test for a full turn - the end along the start radius
+        sx, sy = first[0] - cx, first[1] - cy
+        ex, ey = last[0] - cx, last[1] - cy
+        if sx * ey - sy * ex == 0 and sx * ex + sy * ey >= 0:
+            line = [first] if last == first else [first, last]
+            return [_as_point((x, y, flags)) for x, y in line]
+    centre_flags = FLAG_ARC_CENTRE | (FLAG_ARC_CLOCKWISE if sweep < 0 else 0)
+    return [
+        _as_point((first[0], first[1], flags)),
+        _as_point((cx, cy, centre_flags)),
+        _as_point((last[0], last[1], flags)),
+    ]
+
+
+def cmd_frame_data(chunk: bytes) -> str:
+    if not 0 < len(chunk) <= MAX_CHUNK_BYTES:
+        raise ValueError(f"chunk must be 1..{MAX_CHUNK_BYTES} bytes")
+    return f"frame data {chunk.hex()}"
+
+
+def build_frame_stream_sequence(
+    points: Sequence, chunk_bytes: int = MAX_CHUNK_BYTES
+) -> List[str]:
+    """
+    Build a 'frame begin -> frame data* -> frame commit' upload.
+
+    Uses far fewer bytes on the link than build_frame_sequence - typically
+    2 bytes per point instead of ~25 characters.
+    """
+    return build_data_sequence(
+        cmd_frame_begin(len(points)), encode_points(points), chunk_bytes
+    )
+
+
+def build_data_sequence(
+    begin: str, data: bytes, chunk_bytes: int = MAX_CHUNK_BYTES
+) -> List[str]:
+    """
+    Build a 'begin -> frame data* -> frame commit' upload, sending data in
+    chunks the firmware's command line buffer takes. Shared by every frame
+    format that is uploaded as bytes.
+    """
+    cmds: List[str] = [begin]
+    for i in range(0, len(data), chunk_bytes):
+        cmds.append(cmd_frame_data(data[i : i + chunk_bytes]))
+    cmds.append(cmd_frame_commit())
+    return cmds
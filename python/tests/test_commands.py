@@ -6,6 +6,15 @@ from serialio.commands import (
     cmd_clear,
     cmd_size,
     build_write_sequence_from_buffer,
+    cmd_frame_begin,
+    cmd_frame_begin_abs,
+    cmd_frame_point,
+    cmd_frame_commit,
+    cmd_frame_info,
+    build_frame_sequence,
+    cmd_xform,
+    cmd_grid,
+    build_grid_sequence,
     INACTIVE,
 )
 from unittest.mock import Mock
@@ -369,6 +378,73 @@ class TestBuildWriteSequenceFromBuffer(unittest.TestCase):
             f"WRITE 255 {expected_x} {expected_y} {expected_flags} INACTIVE",
         )
 
+    def test_cmd_frame_begin(self):
+        """Test frame begin command generation and range"""
+        self.assertEqual(cmd_frame_begin(1), "frame begin 1")
+        self.assertEqual(cmd_frame_begin(255), "frame begin 255")
+        with self.assertRaises(ValueError):
+            cmd_frame_begin(0)
+        with self.assertRaises(ValueError):
+            cmd_frame_begin(256)
+
+    def test_cmd_frame_begin_abs(self):
+        """Test absolute frame begin command generation"""
+        self.assertEqual(cmd_frame_begin_abs(3), "frame begin_abs 3")
+        with self.assertRaises(ValueError):
+            cmd_frame_begin_abs(0)
+
+    def test_cmd_frame_point(self):
+        """Test frame point command generation"""
+        self.assertEqual(cmd_frame_point(0, 1, 2, 64), "frame point 0 1 2 64")
+        with self.assertRaises(ValueError):
+            cmd_frame_point(0, 256, 0, 0)
+
+    def test_cmd_frame_commit_and_info(self):
+        """Test frame commit/info command generation"""
+        self.assertEqual(cmd_frame_commit(), "frame commit")
+        self.assertEqual(cmd_frame_info(), "frame info")
+
+    def test_cmd_xform(self):
+        """Test output transform command generation"""
+        self.assertEqual(cmd_xform(), "xform 64 0 0 0")
+        self.assertEqual(cmd_xform(0.5, 90, -10, 20), "xform 32 64 -10 20")
+        self.assertEqual(cmd_xform(angle_deg=-90), "xform 64 192 0 0")
+        with self.assertRaises(ValueError):
+            cmd_xform(scale=4.5)
+        with self.assertRaises(ValueError):
+            cmd_xform(dx=128)
+
+    def test_cmd_grid(self):
+        """Test correction grid node commands"""
+        self.assertEqual(cmd_grid(1, 4, -20, 511), "grid 1 4 -20 511")
+        with self.assertRaises(ValueError):
+            cmd_grid(5, 0, 0, 0)
+        with self.assertRaises(ValueError):
+            cmd_grid(0, 0, -512, 0)
+
+        sequence = build_grid_sequence([[(0, 0)] * 5] * 5)
+        self.assertEqual(len(sequence), 26)
+        self.assertEqual(sequence[6], "grid 1 1 0 0")
+        self.assertEqual(sequence[-1], "set grid_correction 1")
+        with self.assertRaises(ValueError):
+            build_grid_sequence([[(0, 0)] * 5] * 4)
+
+    def test_build_frame_sequence(self):
+        """Test building a frame upload from tuples and step objects"""
+        step = Mock()
+        step.x, step.y, step.flags = 7, 8, 128
+        sequence = build_frame_sequence([(1, 2, 0), step])
+
+        self.assertEqual(
+            sequence,
+            [
+                "frame begin 2",
+                "frame point 0 1 2 0",
+                "frame point 1 7 8 128",
+                "frame commit",
+            ],
+        )
+
 
 if __name__ == "__main__":
     unittest.main()
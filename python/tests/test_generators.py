@@ -0,0 +1,63 @@
+import unittest
+
+from serialio.generators import (
+    GENERATOR_GRID,
+    GENERATOR_TEST,
+    TEST_PATTERN_POINTS,
+    Generator,
+    build_generator_sequence,
+    encode_generators,
+    grid,
+    ilda_pattern,
+    lissajous,
+    polygon,
+    spiral,
+)
+
+
+class TestGenerators(unittest.TestCase):
+    """Test the generator figure encoder"""
+
+    def test_encode(self):
+        """Test the 11 byte figure layout"""
+        data = encode_generators(
+            [
+                lissajous(3, 2, points=100, loops=4, drift=-8),
+                polygon(5, 2, x=10, y=20, rx=30, ry=40, angle=64),
+            ]
+        )
+        self.assertEqual(
+            data,
+            bytes([0, 128, 128, 120, 120, 100, 4, 3, 2, 64, 248])
+            + bytes([2, 10, 20, 30, 40, 0, 1, 5, 2, 64, 0]),
+        )
+
+    def test_point_count(self):
+        """Test the point count matches the firmware's"""
+        self.assertEqual(lissajous(1, 1, points=50, loops=3).point_count(), 153)
+        self.assertEqual(spiral(4, points=80, loops=0).point_count(), 81)
+        self.assertEqual(polygon(6).point_count(), 7)
+        self.assertEqual(grid(4, 3).point_count(), 14)
+        self.assertEqual(ilda_pattern().point_count(), TEST_PATTERN_POINTS)
+
+    def test_validation(self):
+        """Test bad kinds and parameters are rejected"""
+        with self.assertRaises(ValueError):
+            Generator(9).encode()
+        with self.assertRaises(ValueError):
+            lissajous(1, 1, points=0).encode()
+        with self.assertRaises(ValueError):
+            polygon(1).encode()
+        with self.assertRaises(ValueError):
+            Generator(GENERATOR_GRID).encode()
+        with self.assertRaises(ValueError):
+            Generator(GENERATOR_TEST, rx=300).encode()
+        with self.assertRaises(ValueError):
+            build_generator_sequence([])
+        with self.assertRaises(ValueError):
+            encode_generators([lissajous(1, 1, points=255, loops=5)])
+        encode_generators([lissajous(1, 1, points=255, loops=4)])
+
+
+if __name__ == "__main__":
+    unittest.main()
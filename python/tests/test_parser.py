@@ -1,7 +1,12 @@
 import unittest
 from unittest.mock import Mock, patch, MagicMock
 
-from serialio.parser import is_eoc, accumulate_dump_lines, parse_dump_text
+from serialio.parser import (
+    is_eoc,
+    accumulate_dump_lines,
+    parse_dump_text,
+    parse_frame_summary,
+)
 
 
 class TestParser(unittest.TestCase):
@@ -331,6 +336,21 @@ class TestParser(unittest.TestCase):
             mock_buffer_data.from_dump_response.assert_called_once_with(expected_text)
             self.assertEqual(result, mock_instance)
 
+    def test_parse_frame_summary(self):
+        """Test parsing the summary printed by 'frame commit'"""
+        self.assertEqual(
+            parse_frame_summary(
+                "OK steps=812 frame_us=81200 blank_pct=12 table=1\r\n"
+            ),
+            {"steps": 812, "frame_us": 81200, "blank_pct": 12, "table": 1},
+        )
+
+    def test_parse_frame_summary_rejects_other_lines(self):
+        """Test non-summary lines are rejected"""
+        self.assertIsNone(parse_frame_summary("ERR: No frame to commit"))
+        self.assertIsNone(parse_frame_summary("OK"))
+        self.assertIsNone(parse_frame_summary("OK steps=abc"))
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,81 @@
+import unittest
+
+from serialio.program import (
+    MAX_PASS_POINTS,
+    Program,
+    build_program_sequence,
+    run_program,
+)
+from serialio.wire import FLAG_BLANK
+
+
+class TestProgram(unittest.TestCase):
+    """Test the display list assembler against the reference interpreter"""
+
+    def tiled_squares(self) -> bytes:
+        prog = Program()
+        prog.repeat(3).push().call("square").pop().translate(60, 0).next()
+        prog.end()
+        prog.label("square")
+        prog.move(20, 20).line_rel(40, 0).line_rel(0, 40)
+        prog.line_rel(-40, 0).line_rel(0, -40).ret()
+        return prog.assemble()
+
+    def test_assemble(self):
+        """Test instruction layout and label fixups"""
+        code = self.tiled_squares()
+        self.assertEqual(code[:4], bytes([0x07, 3, 0x0B, 0x09]))
+        sub = code[4] | code[5] << 8
+        self.assertEqual(code[sub], 0x01)
+        self.assertEqual(Program().line_rel(-1, 2).assemble(), bytes([0x04, 0xFF, 2]))
+        with self.assertRaises(ValueError):
+            Program().call("missing").assemble()
+        with self.assertRaises(ValueError):
+            Program().repeat(0)
+        with self.assertRaises(ValueError):
+            Program().translate(128, 0)
+
+    def test_run(self):
+        """Test loops, calls and the offset stack"""
+        points = run_program(self.tiled_squares())
+        self.assertEqual(len(points), 15)
+        self.assertEqual(points[0], (20, 20, FLAG_BLANK))
+        self.assertEqual(points[1], (60, 20, 0))
+        self.assertEqual(points[5], (80, 20, FLAG_BLANK))
+        self.assertEqual(points[14], (140, 20, 0))
+
+        blanked = run_program(Program().blank().line(1, 2).blank(False).line(3, 4).assemble())
+        self.assertEqual(blanked, [(1, 2, FLAG_BLANK), (3, 4, 0)])
+
+    def test_pass_limit(self):
+        """Test a long pass stops at the firmware's point limit"""
+        code = Program().repeat(200).repeat(10).move(1, 1).next().next().assemble()
+        self.assertEqual(len(run_program(code)), MAX_PASS_POINTS)
+
+    def test_faults(self):
+        """Test programs the firmware rejects when committed"""
+        busy = Program().repeat(200).repeat(10)
+        for _ in range(8):
+            busy.translate(0, 0)
+        bad = [
+            bytes([0x0E]),
+            bytes([0x01, 5]),
+            bytes([0x08]),
+            bytes([0x0A]),
+            bytes([0x0C]),
+            bytes([0x09, 0xFF, 0x00]),
+            bytes([0x07, 5, 0x08]),
+            bytes([0x00]),
+            bytes([0x0B] * 5 + [0x01, 1, 1]),
+            bytes([0x01, 1, 1, 0x09, 0x03, 0x00]),
+            busy.move(1, 1).next().next().assemble(),
+        ]
+        for code in bad:
+            with self.assertRaises(ValueError, msg=code.hex()):
+                run_program(code)
+        with self.assertRaises(ValueError):
+            build_program_sequence(b"")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,211 @@
+import os
+import struct
+import sys
+import tempfile
+import unittest
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).parent.parent.parent / "arduino"))
+
+from show_compiler import (
+    ARC_CENTRE,
+    BLANK,
+    CURVE_CONTROL,
+    ShowError,
+    compact_frame,
+    compile_show,
+    load_ilda,
+    load_svg,
+)
+
+
+def ilda_section(fmt, records):
+    """One ILDA header and its records - (x, y, blanked) for point formats."""
+    header = b"ILDA" + bytes([0, 0, 0, fmt]) + bytes(16) + struct.pack(">HHHBB", len(records), 0, 1, 0, 0)
+    body = b""
+    for record in records:
+        if fmt == 2:
+            body += bytes(record)
+            continue
+        x, y, blanked = record
+        body += struct.pack(">hh", x, y)
+        if fmt in (0, 4):
+            body += struct.pack(">h", 0)  # z
+        status = 0x40 if blanked else 0
+        if fmt in (0, 1):
+            body += bytes([status, 0])
+        else:
+            body += bytes([status, 1, 2, 3])
+    return header + body
+
+
+def ilda_end():
+    return ilda_section(0, [])
+
+
+class TestShowCompiler(unittest.TestCase):
+    """Test the show compiler's loaders and frame compaction"""
+
+    def setUp(self):
+        self.dir = tempfile.TemporaryDirectory()
+
+    def tearDown(self):
+        self.dir.cleanup()
+
+    def write(self, name, data):
+        path = os.path.join(self.dir.name, name)
+        with open(path, "wb" if isinstance(data, bytes) else "w") as f:
+            f.write(data)
+        return path
+
+    def test_ilda_formats(self):
+        """Test every supported record layout reads the same frame"""
+        records = [(-32768, -32768, True), (0, 0, False), (32767, 32767, False)]
+        for fmt in (0, 1, 4, 5):
+            with self.subTest(fmt=fmt):
+                path = self.write(f"f{fmt}.ild", ilda_section(fmt, records) + ilda_end())
+                frames = load_ilda(path)
+                self.assertEqual(len(frames), 1)
+                self.assertEqual(
+                    [(round(x, 2), round(y, 2), f) for x, y, f in frames[0]],
+                    [(0.0, 0.0, BLANK), (128.0, 128.0, 0), (256.0, 256.0, 0)],
+                )
+
+    def test_ilda_sections(self):
+        """Test palettes are skipped and each point section is a frame"""
+        data = (
+            ilda_section(2, [(255, 0, 0), (0, 255, 0)])
+            + ilda_section(1, [(0, 0, True), (256, 0, False)])
+            + ilda_section(5, [(0, 256, True)])
+            + ilda_end()
+        )
+        frames = load_ilda(self.write("two.ild", data))
+        self.assertEqual(len(frames), 2)
+        self.assertEqual(frames[0][1], (129.0, 128.0, 0))
+        self.assertEqual(frames[1], [(128.0, 129.0, BLANK)])
+
+    def test_ilda_errors(self):
+        """Test bad headers, unknown formats and empty files are rejected"""
+        for data in (
+            b"ILDX" + bytes(28),
+            ilda_section(3, [(0, 0, False)]),
+            ilda_end(),
+        ):
+            with self.subTest(data=data[:8]):
+                with self.assertRaises(ShowError):
+                    load_ilda(self.write("bad.ild", data))
+
+    def svg(self, body, box="0 0 255 255"):
+        path = self.write(
+            "t.svg", f'<svg xmlns="http://www.w3.org/2000/svg" viewBox="{box}">{body}</svg>'
+        )
+        return [(round(x, 3), round(y, 3), f) for x, y, f in load_svg(path)[0]]
+
+    def test_svg_lines(self):
+        """Test absolute and relative moves, lines and closepath, y flipped"""
+        points = self.svg('<path d="M 10 20 L 30 20 h 10 v 5 z m 5 5 l 1 1"/>')
+        self.assertEqual(
+            points,
+            [
+                (10, 235, BLANK),
+                (30, 235, 0),
+                (40, 235, 0),
+                (40, 230, 0),
+                (10, 235, 0),
+                (15, 230, BLANK),
+                (16, 229, 0),
+            ],
+        )
+
+    def test_svg_curves(self):
+        """Test Bezier curves keep their control points, smooth ones reflected"""
+        points = self.svg('<path d="M0 255 C 10 245 20 245 30 255 S 50 265 60 255 Q 70 245 80 255 T 100 255"/>')
+        self.assertEqual(
+            points,
+            [
+                (0, 0, BLANK),
+                (10, 10, CURVE_CONTROL),
+                (20, 10, CURVE_CONTROL),
+                (30, 0, 0),
+                (40, -10, CURVE_CONTROL),
+                (50, -10, CURVE_CONTROL),
+                (60, 0, 0),
+                (70, 10, CURVE_CONTROL),
+                (80, 0, 0),
+                (90, -10, CURVE_CONTROL),
+                (100, 0, 0),
+            ],
+        )
+
+    def test_svg_shapes(self):
+        """Test circles become arcs and the view box is scaled to the field"""
+        points = self.svg('<circle cx="50" cy="50" r="25"/>', box="0 0 100 100")
+        self.assertEqual(points, [(191.25, 127.5, BLANK), (127.5, 127.5, ARC_CENTRE), (191.25, 127.5, 0)])
+
+        arc = self.svg('<path d="M 0 127.5 A 127.5 127.5 0 0 1 255 127.5"/>')
+        self.assertEqual(arc[0], (0, 127.5, BLANK))
+        self.assertEqual(arc[-1], (255, 127.5, 0))
+        self.assertEqual(len(arc), 1 + 16)  # Half a turn of ARC_SEGMENTS
+        for x, y, _ in arc:
+            self.assertAlmostEqual((x - 127.5) ** 2 + (y - 127.5) ** 2, 127.5**2, delta=1)
+
+        with self.assertRaises(ShowError):
+            self.svg('<path d="M 0 0 L 10"/>')
+        with self.assertRaises(ShowError):
+            self.svg("<g/>")
+
+    def test_tolerance(self):
+        """Test straight runs collapse within the tolerance only"""
+        bowed = [(0, 0, BLANK), (25, 0.7, 0), (50, 1.4, 0), (75, 0.7, 0), (100, 0, 0)]
+        self.assertEqual(compact_frame(bowed, 1.5), [(0, 0, BLANK), (100, 0, 0)])
+        self.assertEqual(compact_frame(bowed, 1.0), [(0, 0, BLANK), (50, 1, 0), (100, 0, 0)])
+
+        corner = [(0, 0, BLANK), (50, 0, 0), (100, 0, 0), (100, 50, 0), (100, 100, 0)]
+        self.assertEqual(compact_frame(corner, 10), [(0, 0, BLANK), (100, 0, 0), (100, 100, 0)])
+        self.assertEqual(compact_frame(corner, 200), [(0, 0, BLANK), (100, 100, 0)])
+
+    def test_compact(self):
+        """Test blanked runs keep only their end and curve points are kept"""
+        frame = [
+            (0, 0, BLANK),
+            (10, 10, BLANK),
+            (20, 20, BLANK),
+            (30, 20, 0),
+            (30, 20, 0),
+            (40, 40, CURVE_CONTROL),
+            (50, 20, 0),
+            (60, 20, 0),
+        ]
+        self.assertEqual(
+            compact_frame(frame),
+            [(20, 20, BLANK), (30, 20, 0), (40, 40, CURVE_CONTROL), (50, 20, 0), (60, 20, 0)],
+        )
+
+    def test_compile(self):
+        """Test the show folder becomes sprites in file name order"""
+        show_dir = os.path.join(self.dir.name, "show")
+        os.mkdir(show_dir)
+        with open(os.path.join(show_dir, "b.svg"), "w") as f:
+            f.write('<svg viewBox="0 0 255 255"><line x1="0" y1="0" x2="255" y2="255"/></svg>')
+        with open(os.path.join(show_dir, "a.ild"), "wb") as f:
+            f.write(ilda_section(1, [(0, 0, True), (1000, 0, False)]) + ilda_end())
+
+        out = os.path.join(self.dir.name, "show_data.cpp")
+        show = compile_show(show_dir, out, 100)
+        self.assertEqual([r[0] for r in show.report], ["a.ild", "b.svg"])
+        self.assertEqual(show.frames, [(6, 1, 100), (7, 1, 100)])
+        with open(out) as f:
+            source = f.read()
+        self.assertIn('#include "renderer/show.h"', source)
+        self.assertIn("const uint16_t show_frame_count = 2;", source)
+
+        # Unchanged output is left alone
+        mtime = os.stat(out).st_mtime_ns
+        os.utime(out, ns=(0, 0))
+        compile_show(show_dir, out, 100)
+        self.assertEqual(os.stat(out).st_mtime_ns, 0)
+        self.assertNotEqual(mtime, 0)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,37 @@
+import unittest
+
+from serialio.sprites import (
+    POLICY_CONNECT,
+    SPRITE_CIRCLE,
+    SPRITE_STAR,
+    SpriteInstance,
+    build_sprite_sequence,
+    encode_instances,
+)
+
+
+class TestSprites(unittest.TestCase):
+    """Test the sprite instance encoder"""
+
+    def test_encode(self):
+        """Test the 6 byte instance layout"""
+        data = encode_instances(
+            [
+                SpriteInstance(SPRITE_STAR, 10, 20),
+                SpriteInstance(SPRITE_CIRCLE, 1, 2, 96, -64, POLICY_CONNECT),
+            ]
+        )
+        self.assertEqual(data, bytes([3, 10, 20, 64, 0, 0, 2, 1, 2, 96, 192, 1]))
+
+    def test_validation(self):
+        """Test out of range fields are rejected"""
+        with self.assertRaises(ValueError):
+            SpriteInstance(SPRITE_STAR, 256, 0).encode()
+        with self.assertRaises(ValueError):
+            SpriteInstance(SPRITE_STAR, 0, 0, policy=7).encode()
+        with self.assertRaises(ValueError):
+            build_sprite_sequence([])
+
+
+if __name__ == "__main__":
+    unittest.main()
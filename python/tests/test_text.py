@@ -0,0 +1,58 @@
+import unittest
+
+from serialio.text import (
+    HERSHEY_WIDTHS,
+    LAST_CHAR,
+    FIRST_CHAR,
+    RUN_HEADER_BYTES,
+    TextRun,
+    build_text_sequence,
+    encode_runs,
+    text_width,
+)
+
+
+class TestText(unittest.TestCase):
+    """Test the text run encoder"""
+
+    def test_widths(self):
+        """Test the width table covers the font"""
+        self.assertEqual(len(HERSHEY_WIDTHS), LAST_CHAR - FIRST_CHAR + 1)
+        self.assertEqual(HERSHEY_WIDTHS[ord("A") - FIRST_CHAR], 18)
+
+    def test_encode(self):
+        """Test the run header layout"""
+        data = encode_runs([TextRun("Hi", -300, 20, 32, -2), TextRun("", 1, 2)])
+        self.assertEqual(
+            data,
+            bytes([0xD4, 0xFE, 20, 32, 0xFE, 2, ord("H"), ord("i"), 1, 0, 2, 16, 0, 0]),
+        )
+
+    def test_unknown_characters(self):
+        """Test characters outside the font are sent as '?'"""
+        self.assertEqual(TextRun("é\n", 0, 0).encode()[RUN_HEADER_BYTES:], b"??")
+        self.assertEqual(text_width("é"), text_width("?"))
+
+    def test_width(self):
+        """Test the advance rounds per character like the firmware"""
+        self.assertEqual(text_width("AA"), 36)
+        self.assertEqual(text_width("AA", spacing=2), 40)
+        self.assertEqual(text_width("I", size=24), 12)  # 8 * 1.5
+        self.assertEqual(text_width("!", size=9), 6)  # 10 * 9 / 16 = 5.6
+
+    def test_validation(self):
+        """Test out of range fields are rejected"""
+        with self.assertRaises(ValueError):
+            TextRun("A", 40000, 0).encode()
+        with self.assertRaises(ValueError):
+            TextRun("A", 0, 256).encode()
+        with self.assertRaises(ValueError):
+            TextRun("A", 0, 0, spacing=128).encode()
+        with self.assertRaises(ValueError):
+            TextRun("A" * 256, 0, 0).encode()
+        with self.assertRaises(ValueError):
+            build_text_sequence([])
+
+
+if __name__ == "__main__":
+    unittest.main()
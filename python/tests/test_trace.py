@@ -0,0 +1,94 @@
+import unittest
+
+from serialio.trace import (
+    FRAME_SIZE,
+    TRACE_EVENTS,
+    TraceDecoder,
+    encode_frame,
+    event_mask,
+)
+
+
+class TestTraceDecoder(unittest.TestCase):
+    """Test decoding of the firmware's binary trace frames"""
+
+    def test_frame_size(self):
+        """Frames are 8 bytes on the wire"""
+        self.assertEqual(len(encode_frame(0, 0, 0, 0)), FRAME_SIZE)
+
+    def test_decode_single_record(self):
+        """A single frame decodes to its fields"""
+        decoder = TraceDecoder()
+        records = decoder.feed(encode_frame(0x1234, 4, 7, 0xC880))
+        self.assertEqual(len(records), 1)
+        r = records[0]
+        self.assertEqual(r.timestamp, 0x1234)
+        self.assertEqual(r.event, 4)
+        self.assertEqual(r.name, "TRANSITION")
+        self.assertEqual(r.a, 7)
+        self.assertEqual(r.b, 0xC880)
+        self.assertEqual(r.time_us, 0)
+
+    def test_split_across_feeds(self):
+        """Frames split across reads are reassembled"""
+        decoder = TraceDecoder()
+        frame = encode_frame(10, 3, 0, 0)
+        self.assertEqual(decoder.feed(frame[:3]), [])
+        records = decoder.feed(frame[3:])
+        self.assertEqual(len(records), 1)
+        self.assertEqual(records[0].name, "STEP_UNDERRUN")
+
+    def test_text_passthrough(self):
+        """ASCII output interleaved with frames is passed through"""
+        decoder = TraceDecoder()
+        data = b"Timer reloaded\r\n" + encode_frame(1, 8, 4, 0) + b"OK\r\n"
+        records = decoder.feed(data)
+        self.assertEqual(len(records), 1)
+        self.assertEqual(decoder.take_text(), "Timer reloaded\r\nOK\r\n")
+        self.assertEqual(decoder.take_text(), "")
+
+    def test_bad_checksum_resyncs(self):
+        """Corrupt frames are skipped and the next good frame is found"""
+        decoder = TraceDecoder()
+        bad = bytearray(encode_frame(5, 6, 1, 2))
+        bad[-1] ^= 0xFF
+        records = decoder.feed(bytes(bad) + encode_frame(6, 6, 2, 3))
+        self.assertEqual(len(records), 1)
+        self.assertEqual(records[0].a, 2)
+        self.assertEqual(decoder.frames_bad, 1)
+
+    def test_sync_byte_in_payload(self):
+        """A payload containing the sync byte still decodes"""
+        decoder = TraceDecoder()
+        records = decoder.feed(encode_frame(0xA5A5, 0, 0xA5, 0xA5A5))
+        self.assertEqual(len(records), 1)
+        self.assertEqual(records[0].timestamp, 0xA5A5)
+
+    def test_timestamp_unwrap(self):
+        """16 bit timestamps are unwrapped into microseconds"""
+        decoder = TraceDecoder()
+        data = (
+            encode_frame(0xFFF0, 7, 0, 0)
+            + encode_frame(0x0010, 7, 0, 1)
+            + encode_frame(0x0020, 7, 0, 2)
+        )
+        records = decoder.feed(data)
+        self.assertEqual([r.time_us for r in records], [0, 0x20 * 4, 0x30 * 4])
+
+    def test_event_mask(self):
+        """Event masks are built from names"""
+        self.assertEqual(event_mask("overflow"), 1)
+        self.assertEqual(event_mask("STEP_POP", "STEP_PUSH"), 0b110)
+        with self.assertRaises(ValueError):
+            event_mask("nonsense")
+
+    def test_unknown_event_name(self):
+        """Unknown event IDs still get a printable name"""
+        decoder = TraceDecoder()
+        record = decoder.feed(encode_frame(0, 12, 0, 0))[0]
+        self.assertNotIn(12, TRACE_EVENTS)
+        self.assertEqual(record.name, "EVENT_12")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,192 @@
+import unittest
+
+from serialio.generators import build_generator_sequence, encode_generators, polygon
+from serialio.program import Program, build_program_sequence
+from serialio.sprites import SpriteInstance, build_sprite_sequence, encode_instances
+from serialio.text import TextRun, build_text_sequence, encode_runs
+from serialio.wire import (
+    MAX_CHUNK_BYTES,
+    arc_points,
+    build_data_sequence,
+    build_frame_stream_sequence,
+    cmd_frame_data,
+    curve_points,
+    decode_points,
+    encode_points,
+    encode_varint,
+    unzigzag,
+    zigzag,
+)
+
+
+class TestWireEncoding(unittest.TestCase):
+    """Test the frame wire encoder against the reference decoder"""
+
+    def test_zigzag(self):
+        """Test zigzag mapping over the full signed 8 bit range"""
+        self.assertEqual([zigzag(v) for v in (0, -1, 1, -2, 2)], [0, 1, 2, 3, 4])
+        for v in range(-128, 128):
+            self.assertEqual(unzigzag(zigzag(v)), v)
+        self.assertEqual(zigzag(-128), 255)
+
+    def test_varint(self):
+        """Test varint byte layout"""
+        self.assertEqual(encode_varint(0), b"\x00")
+        self.assertEqual(encode_varint(127), b"\x7f")
+        self.assertEqual(encode_varint(128), b"\x80\x01")
+        self.assertEqual(encode_varint(1023), b"\xff\x07")
+
+    def test_first_point_absolute(self):
+        """Test the first point is sent as raw x, y, flags"""
+        self.assertEqual(encode_points([(10, 20, 64)]), bytes([10, 20, 64]))
+
+    def test_small_delta_is_two_bytes(self):
+        """Test a small move with unchanged flags takes two bytes"""
+        data = encode_points([(10, 10, 0), (12, 7, 0)])
+        self.assertEqual(len(data), 5)
+        self.assertEqual(data[3:], bytes([zigzag(2) << 2, zigzag(-3)]))
+
+    def test_flag_change(self):
+        """Test a flag change is carried in the record"""
+        points = [(0, 0, 64), (5, 5, 0), (6, 6, 0)]
+        self.assertEqual(decode_points(encode_points(points)), points)
+
+    def test_repeats_collapse_to_runs(self):
+        """Test repeated blanked points become a single run record"""
+        points = [(100, 100, 64)] * 20 + [(101, 100, 64)]
+        data = encode_points(points)
+        self.assertEqual(len(data), 3 + 1 + 2)
+        self.assertEqual(decode_points(data), points)
+
+    def test_long_runs_split(self):
+        """Test runs longer than 255 points are split"""
+        points = [(1, 2, 64)] * 600
+        self.assertEqual(decode_points(encode_points(points)), points)
+
+    def test_wrapping_deltas(self):
+        """Test full-scale jumps use the modulo 256 delta"""
+        points = [(0, 255, 0), (255, 0, 0), (128, 127, 128)]
+        self.assertEqual(decode_points(encode_points(points)), points)
+
+    def test_round_trip_outline(self):
+        """Test a typical outline compresses well and round trips"""
+        import math
+
+        points = [
+            (
+                int(128 + 100 * math.cos(i * math.tau / 100)),
+                int(128 + 100 * math.sin(i * math.tau / 100)),
+                0,
+            )
+            for i in range(100)
+        ]
+        data = encode_points(points)
+        self.assertEqual(decode_points(data), points)
+        # Two bytes per point, against ~20 characters for 'frame point'
+        self.assertLessEqual(len(data), 3 + 2 * (len(points) - 1))
+
+    def test_rejects_bad_values(self):
+        """Test out of range coordinates are rejected"""
+        with self.assertRaises(ValueError):
+            encode_points([(256, 0, 0)])
+
+    def test_decode_rejects_truncated(self):
+        """Test the reference decoder rejects truncated records"""
+        data = encode_points([(0, 0, 0), (100, 100, 0)])
+        with self.assertRaises(ValueError):
+            decode_points(data[:-1])
+
+    def test_curve_points(self):
+        """Test curve segments become control points plus the end point"""
+        self.assertEqual(
+            curve_points([(10, 20)], (30, 0)), [(10, 20, 1), (30, 0, 0)]
+        )
+        points = [(0, 0, 0)] + curve_points([(10, 200), (200, 10)], (250, 250))
+        self.assertEqual(points[2], (200, 10, 1))
+        self.assertEqual(decode_points(encode_points(points)), points)
+        with self.assertRaises(ValueError):
+            curve_points([], (0, 0))
+        with self.assertRaises(ValueError):
+            curve_points([(0, 0)] * 3, (0, 0))
+
+    def test_arc_points(self):
+        """Test arcs become start point, centre and end point"""
+        self.assertEqual(
+            arc_points((128, 128), 100, 0, 90),
+            [(228, 128, 0), (128, 128, 2), (128, 228, 0)],
+        )
+        self.assertEqual(
+            arc_points((128, 128), 100, 180, -90, flags=0x40),
+            [(28, 128, 0x40), (128, 128, 6), (128, 228, 0x40)],
+        )
+        circle = arc_points((128, 128), 50, 45, 360)
+        self.assertEqual(circle[0], circle[2])
+        self.assertEqual(decode_points(encode_points(circle)), circle)
+        self.assertEqual(arc_points((128, 128), 50, 0, 0.5), [(178, 128, 0)])
+        self.assertEqual(arc_points((128, 128), 50, 0, -1)[1], (128, 128, 6))
+        with self.assertRaises(ValueError):
+            arc_points((128, 128), 50, 0, 0)
+        with self.assertRaises(ValueError):
+            arc_points((128, 128), 200, 0, 90)
+
+    def test_cmd_frame_data(self):
+        """Test frame data command generation"""
+        self.assertEqual(cmd_frame_data(b"\x01\xab"), "frame data 01ab")
+        with self.assertRaises(ValueError):
+            cmd_frame_data(b"")
+        with self.assertRaises(ValueError):
+            cmd_frame_data(bytes(MAX_CHUNK_BYTES + 1))
+
+    def test_build_frame_stream_sequence(self):
+        """Test the upload is chunked and fits the firmware line buffer"""
+        points = [(i, (i * 7) & 0xFF, 0) for i in range(60)]
+        sequence = build_frame_stream_sequence(points)
+
+        self.assertEqual(sequence[0], "frame begin 60")
+        self.assertEqual(sequence[-1], "frame commit")
+        data = bytes.fromhex(
+            "".join(line.split()[2] for line in sequence[1:-1])
+        )
+        self.assertEqual(decode_points(data), points)
+        for line in sequence:
+            self.assertLess(len(line), 64)
+
+    def test_build_data_sequence(self):
+        """Test byte uploads are split into whole chunks in order"""
+        data = bytes(range(50))
+        self.assertEqual(
+            build_data_sequence("frame begin_gen", data),
+            [
+                "frame begin_gen",
+                f"frame data {data[:24].hex()}",
+                f"frame data {data[24:48].hex()}",
+                f"frame data {data[48:].hex()}",
+                "frame commit",
+            ],
+        )
+        self.assertEqual(len(build_data_sequence("x", data, 10)), 7)
+        self.assertEqual(len(build_data_sequence("x", data[:48])), 4)
+        self.assertEqual(build_data_sequence("x", b""), ["x", "frame commit"])
+        with self.assertRaises(ValueError):
+            build_data_sequence("x", data, MAX_CHUNK_BYTES + 1)
+
+    def test_frame_format_sequences(self):
+        """Test each byte frame format starts its own upload"""
+        prog = Program().move(10, 10).line_rel(20, 0).next()
+        prog.end()
+        figures = [polygon(3 + i) for i in range(4)]
+        instances = [SpriteInstance(i % 6, i, i) for i in range(10)]
+        runs = [TextRun("SCROLLING TEXT", 255 - i * 40, 100) for i in range(4)]
+        cases = [
+            (build_program_sequence(prog.assemble()), "frame begin_prog", prog.assemble()),
+            (build_generator_sequence(figures), "frame begin_gen", encode_generators(figures)),
+            (build_sprite_sequence(instances), "frame begin_sprites", encode_instances(instances)),
+            (build_text_sequence(runs), "frame begin_text", encode_runs(runs)),
+        ]
+        for cmds, begin, data in cases:
+            with self.subTest(begin=begin):
+                self.assertEqual(cmds, build_data_sequence(begin, data))
+
+
+if __name__ == "__main__":
+    unittest.main()